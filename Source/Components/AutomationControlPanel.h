@@ -158,6 +158,11 @@ public:
     void setReturnTime(double returnVal) { returnKnob.setValue(returnVal); }
     double getReturnTime() const { return returnKnob.getValue(); }
     
+    // Beats mode: the time knobs as the note lengths they show, in quarter notes
+    double getDelayBeats() const { return delayKnob.getValueInBeats(); }
+    double getAttackBeats() const { return attackKnob.getValueInBeats(); }
+    double getReturnBeats() const { return returnKnob.getValueInBeats(); }
+    
     void setCurveValue(double curve) { curveKnob.setValue(curve); }
     double getCurveValue() const { return curveKnob.getValue(); }
     
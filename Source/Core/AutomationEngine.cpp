@@ -1,35 +1,39 @@
 #include "AutomationEngine.h"
+#include "CoreLog.h"
 
 //==============================================================================
 AutomationEngine::AutomationEngine()
 {
-    DBG("AutomationEngine: Created");
+    activeSlots.fill(-1);
+    pendingUpdates.reserve(NUM_SLIDERS);
+    outputClock = std::make_unique<OutputClock>(*this);
+    
+    CORE_LOG_DEBUG("AutomationEngine", "Created");
 }
 
 AutomationEngine::~AutomationEngine()
 {
-    // Stop timer before destruction
+    // Stop timers before destruction
+    outputClock->stopTimer();
     stopTimer();
     
-    DBG("AutomationEngine: Destroyed");
+    CORE_LOG_DEBUG("AutomationEngine", "Destroyed");
 }
 
 //==============================================================================
 void AutomationEngine::startAutomation(int sliderIndex, const AutomationParams& params)
 {
-    if (sliderIndex < 0 || sliderIndex >= 16)
+    if (sliderIndex < 0 || sliderIndex >= NUM_SLIDERS)
         return;
-        
-    auto& automation = automations[sliderIndex];
     
     // Don't start if already automating
-    if (automation.isActive)
+    if (findAutomation(sliderIndex) != nullptr)
         return;
     
     // Check if there's enough change to warrant automation
     if (std::abs(params.targetValue - params.startValue) < MIN_VALUE_CHANGE)
     {
-        DBG("AutomationEngine: Target too close to start value, skipping automation");
+        CORE_LOG_DEBUG("AutomationEngine", "Target too close to start value, skipping automation");
         return;
     }
     
@@ -37,88 +41,193 @@ void AutomationEngine::startAutomation(int sliderIndex, const AutomationParams&
     if (params.attackTime <= 0.0)
     {
         // Instant change - just update the value directly
-        if (onValueUpdate)
-            onValueUpdate(sliderIndex, params.targetValue);
+        if (onValuesUpdated)
+            onValuesUpdated({ { sliderIndex, params.targetValue } });
         return;
     }
     
-    // Set up automation
-    automation.isActive = true;
-    automation.isInReturnPhase = false;
+    // Set up automation in the next free slot of the active list
+    SliderAutomation automation;
     automation.startTime = juce::Time::getMillisecondCounterHiRes();
+    automation.startBeat = beatClock.getBeatAt(automation.startTime);
     automation.originalValue = params.startValue; // Store original for return phase
     automation.params = params;
     automation.sliderIndex = sliderIndex;
+    automation.isClocked = onClockedOutput != nullptr && getOutputClockRate() > 0;
+    
+    // Curves come from the shared table cache - no std::pow per evaluation, on any thread
+    auto& curveCache = CurveTableCache::getInstance();
+    automation.attackCurve = curveCache.getTableForCurve(params.curveValue);
+    automation.returnCurve = curveCache.getTableForCurve(CurveTable::getInverseCurve(params.curveValue));
+    
+    // The start value is already out - every output path begins on its step
+    int startStep = params.outputGrid.getStepIndex(params.startValue);
+    automation.publishedStepIndex = automation.scheduledStepIndex = automation.clockedStepIndex = startStep;
+    automation.scheduledUntil = automation.startTime;
+    automation.lastScheduledTime = automation.startTime - SCHEDULE_STEP_MS;
+    automation.nextClockedStepTime = getNextOutputStep(automation, startStep, automation.startTime).timeMs;
+    
+    {
+        const juce::SpinLock::ScopedLockType lock(automationLock);
+        activeSlots[(size_t)sliderIndex] = numActive;
+        automations[(size_t)numActive++] = automation;
+    }
     
-    DBG("AutomationEngine: Started automation for slider " << sliderIndex 
+    CORE_LOG_DEBUG("AutomationEngine", "Started automation for slider " << sliderIndex 
         << " from " << params.startValue << " to " << params.targetValue
         << " (delay=" << params.delayTime << "s, attack=" << params.attackTime 
-        << "s, return=" << params.returnTime << "s, curve=" << params.curveValue << ")");
+        << "s, return=" << params.returnTime << "s, curve=" << params.curveValue << ")"
+        << (params.isBeatTimed ? " - times in beats" : ""));
     
     // Notify state change
     if (onAutomationStateChanged)
         onAutomationStateChanged(sliderIndex, true);
     
-    // Start timer if not already running
-    if (!isTimerRunning())
+    // Hand the first lookahead window to the MIDI backend right away
+    auto* started = findAutomation(sliderIndex);
+    if (started != nullptr && isScheduled(*started))
+        renderScheduledOutput(*started, started->startTime + LOOKAHEAD_MS);
+    
+    // Start timers if not already running
+    updateOutputClock();
+    if (numActive > 0 && !isTimerRunning())
         startTimer(TIMER_INTERVAL);
 }
 
 void AutomationEngine::stopAutomation(int sliderIndex)
 {
-    if (sliderIndex < 0 || sliderIndex >= 16)
+    auto* automation = findAutomation(sliderIndex);
+    if (automation == nullptr)
         return;
-        
-    auto& automation = automations[sliderIndex];
     
-    if (!automation.isActive)
-        return;
-        
-    automation.isActive = false;
-    automation.isInReturnPhase = false;
+    bool wasScheduled = isScheduled(*automation);
+    removeAutomation(sliderIndex);
+    
+    CORE_LOG_DEBUG("AutomationEngine", "Stopped automation for slider " << sliderIndex);
     
-    DBG("AutomationEngine: Stopped automation for slider " << sliderIndex);
+    // Stop timers if no more active automations
+    updateOutputClock();
+    if (numActive == 0)
+        stopTimer();
+    
+    // Drop values already handed to the MIDI backend
+    if (wasScheduled && onScheduledOutputCancelled)
+        onScheduledOutputCancelled(sliderIndex);
     
     // Notify state change
     if (onAutomationStateChanged)
         onAutomationStateChanged(sliderIndex, false);
-    
-    // Stop timer if no more active automations
-    if (!hasAnyActiveAutomations())
-        stopTimer();
 }
 
 void AutomationEngine::stopAllAutomations()
 {
-    bool hadActiveAutomations = false;
+    if (numActive == 0)
+        return;
     
-    for (int i = 0; i < 16; ++i)
+    // Empty the list first, so callbacks see no automation still running
+    std::array<int, NUM_SLIDERS> stoppedSliders;
+    std::array<bool, NUM_SLIDERS> wasScheduled;
+    int numStopped = numActive;
+    for (int i = 0; i < numStopped; ++i)
     {
-        if (automations[i].isActive)
-        {
-            automations[i].isActive = false;
-            automations[i].isInReturnPhase = false;
-            hadActiveAutomations = true;
-            
-            // Notify state change
-            if (onAutomationStateChanged)
-                onAutomationStateChanged(i, false);
-        }
+        stoppedSliders[(size_t)i] = automations[(size_t)i].sliderIndex;
+        wasScheduled[(size_t)i] = isScheduled(automations[(size_t)i]);
     }
     
-    if (hadActiveAutomations)
+    for (int i = 0; i < numStopped; ++i)
+        removeAutomation(stoppedSliders[(size_t)i]);
+    
+    updateOutputClock();
+    stopTimer();
+    CORE_LOG_DEBUG("AutomationEngine", "Stopped all automations");
+    
+    for (int i = 0; i < numStopped; ++i)
     {
-        stopTimer();
-        DBG("AutomationEngine: Stopped all automations");
+        if (wasScheduled[(size_t)i] && onScheduledOutputCancelled)
+            onScheduledOutputCancelled(stoppedSliders[(size_t)i]);
+        
+        // Notify state change
+        if (onAutomationStateChanged)
+            onAutomationStateChanged(stoppedSliders[(size_t)i], false);
     }
 }
 
 bool AutomationEngine::isSliderAutomating(int sliderIndex) const
 {
-    if (sliderIndex < 0 || sliderIndex >= 16)
-        return false;
+    return findAutomation(sliderIndex) != nullptr;
+}
+
+bool AutomationEngine::isOutputDrivenByEngine(int sliderIndex) const
+{
+    auto* automation = findAutomation(sliderIndex);
+    return automation != nullptr && (automation->isClocked || isScheduled(*automation));
+}
+
+void AutomationEngine::rescheduleOutput()
+{
+    double now = juce::Time::getMillisecondCounterHiRes();
+    
+    for (int i = 0; i < numActive; ++i)
+    {
+        auto& automation = automations[(size_t)i];
+        if (!isScheduled(automation))
+            continue;
         
-    return automations[sliderIndex].isActive;
+        // Re-render from now, starting with the current value - the clear may have dropped
+        // the step the receiver was about to reach, or the final point
+        automation.scheduledUntil = juce::jmax(now, automation.startTime);
+        automation.scheduledStepIndex = NO_STEP;
+        renderScheduledOutput(automation, now + LOOKAHEAD_MS);
+    }
+}
+
+void AutomationEngine::setBeatClock(const BeatClock& newBeatClock)
+{
+    if (newBeatClock.msPerBeat <= 0.0)
+        return;
+    
+    // Phase corrections that move the next LOOKAHEAD_MS by less than the tolerance are left
+    // to add up, so a steady external clock doesn't re-time output on every update
+    double now = juce::Time::getMillisecondCounterHiRes();
+    double deviation = 0.0;
+    for (double time : { now, now + LOOKAHEAD_MS })
+        deviation = juce::jmax(deviation, std::abs(beatClock.getTimeAt(newBeatClock.getBeatAt(time)) - time));
+    
+    if (deviation < BEAT_CLOCK_TOLERANCE_MS)
+        return;
+    
+    // A transport jump (start, song position, stop) relocates the beat line - running envelopes
+    // carry on from where they are instead of jumping with it. Smaller moves are phase
+    // corrections the envelopes follow, so they stay on the clock's beats.
+    double jump = newBeatClock.getBeatAt(now) - beatClock.getBeatAt(now);
+    bool isRelocation = std::abs(jump) > MAX_PHASE_CORRECTION_BEATS;
+    
+    int retimedScheduledSlider = -1;
+    {
+        const juce::SpinLock::ScopedLockType lock(automationLock);
+        beatClock = newBeatClock;
+        
+        // Beat-timed automations keep their position in beats - only their future times move
+        for (int i = 0; i < numActive; ++i)
+        {
+            auto& automation = automations[(size_t)i];
+            if (!automation.params.isBeatTimed)
+                continue;
+            
+            if (isRelocation)
+                automation.startBeat += jump;
+            
+            if (automation.isClocked && !automation.hasClockedFinalValue)
+                automation.nextClockedStepTime = getNextOutputStep(automation, automation.clockedStepIndex, now).timeMs;
+            else if (isScheduled(automation))
+                retimedScheduledSlider = automation.sliderIndex;
+        }
+    }
+    
+    // Points already handed to the MIDI backend were timed at the old tempo. Clearing is
+    // port-wide and re-renders every running automation, so one request covers them all.
+    if (retimedScheduledSlider >= 0 && onScheduledOutputCancelled)
+        onScheduledOutputCancelled(retimedScheduledSlider);
 }
 
 void AutomationEngine::handleManualOverride(int sliderIndex)
@@ -126,141 +235,394 @@ void AutomationEngine::handleManualOverride(int sliderIndex)
     if (isSliderAutomating(sliderIndex))
     {
         stopAutomation(sliderIndex);
-        DBG("AutomationEngine: Manual override detected for slider " << sliderIndex);
+        CORE_LOG_DEBUG("AutomationEngine", "Manual override detected for slider " << sliderIndex);
     }
 }
 
 //==============================================================================
 void AutomationEngine::timerCallback()
 {
-    for (auto& automation : automations)
+    double now = juce::Time::getMillisecondCounterHiRes();
+    
+    // One pass over the running automations, collecting every new value into one batch
+    pendingUpdates.clear();
+    std::array<int, NUM_SLIDERS> completedSliders;
+    int numCompleted = 0;
+    
+    for (int i = 0; i < numActive; ++i)
     {
-        if (automation.isActive)
+        auto& automation = automations[(size_t)i];
+        
+        if (updateAutomation(automation, now))
+        {
+            completedSliders[(size_t)numCompleted++] = automation.sliderIndex;
+            
+            // The output clock normally sends the final value itself - cover a clock that
+            // hasn't ticked since the end time
+            if (claimClockedFinalValue(automation) && onClockedOutput)
+                onClockedOutput(automation.sliderIndex, automation.params.outputGrid.apply(getFinalValue(automation)));
+        }
+        else if (isScheduled(automation))
         {
-            updateAutomation(automation);
+            renderScheduledOutput(automation, now + LOOKAHEAD_MS); // Keep the MIDI backend LOOKAHEAD_MS ahead
         }
     }
     
-    // Stop timer if no more active automations
-    if (!hasAnyActiveAutomations())
+    // Completed automations still count as running while their final value is published,
+    // so sliders whose output comes from the engine don't send it a second time
+    if (!pendingUpdates.empty() && onValuesUpdated)
+        onValuesUpdated(pendingUpdates);
+    
+    for (int i = 0; i < numCompleted; ++i)
+        removeAutomation(completedSliders[(size_t)i]);
+    
+    // Stop timers if no more active automations
+    updateOutputClock();
+    if (numActive == 0)
         stopTimer();
+    
+    for (int i = 0; i < numCompleted; ++i)
+    {
+        if (onAutomationStateChanged)
+            onAutomationStateChanged(completedSliders[(size_t)i], false);
+    }
 }
 
 //==============================================================================
-double AutomationEngine::applyCurve(double progress, double curveValue) const
+void AutomationEngine::setOutputClockRate(int hz)
 {
-    // Clamp progress to valid range
-    progress = juce::jlimit(0.0, 1.0, progress);
+    outputClockRateHz.store(hz > 0 ? juce::jlimit(MIN_OUTPUT_CLOCK_HZ, MAX_OUTPUT_CLOCK_HZ, hz) : 0, std::memory_order_relaxed);
     
-    if (curveValue < 1.0)
+    // A running clock picks up the new rate straight away
+    if (outputClock->isTimerRunning())
     {
-        // Exponential (0.0 = full exponential, slow start/fast finish)
-        double exponent = 1.0 + (1.0 - curveValue) * 3.0; // Range: 1.0 to 4.0
-        return std::pow(progress, exponent);
+        outputClock->stopTimer();
+        updateOutputClock();
     }
-    else if (curveValue > 1.0)
+}
+
+void AutomationEngine::updateOutputClock()
+{
+    bool hasClockedAutomation = false;
+    for (int i = 0; i < numActive; ++i)
+        hasClockedAutomation |= automations[(size_t)i].isClocked;
+    
+    if (hasClockedAutomation && !outputClock->isTimerRunning())
     {
-        // Logarithmic (2.0 = full logarithmic, fast start/slow finish)
-        double exponent = 1.0 / (1.0 + (curveValue - 1.0) * 3.0); // Range: 1.0 to 0.25
-        return std::pow(progress, exponent);
+        // Automations started while clocked keep the clock even if it was turned off since
+        int rate = getOutputClockRate() > 0 ? getOutputClockRate() : DEFAULT_OUTPUT_CLOCK_HZ;
+        outputClock->startTimer(juce::jmax(1, juce::roundToInt(1000.0 / rate)));
     }
-    else
+    else if (!hasClockedAutomation && outputClock->isTimerRunning())
+    {
+        outputClock->stopTimer();
+    }
+}
+
+void AutomationEngine::clockOutput()
+{
+    // Never wait for the message thread - a tick that finds the list being changed is skipped
+    const juce::SpinLock::ScopedTryLockType lock(automationLock);
+    if (!lock.isLocked() || !onClockedOutput)
+        return;
+    
+    double now = juce::Time::getMillisecondCounterHiRes();
+    
+    for (int i = 0; i < numActive; ++i)
     {
-        // Linear (curveValue == 1.0)
-        return progress;
+        auto& automation = automations[(size_t)i];
+        
+        // Between steps (and during the delay phase) there is nothing to evaluate
+        if (!automation.isClocked || automation.hasClockedFinalValue || now < automation.nextClockedStepTime)
+            continue;
+        
+        const auto& grid = automation.params.outputGrid;
+        double elapsed = getElapsedAt(automation, now);
+        int stepIndex = grid.getStepIndex(calculateValueAt(automation, elapsed));
+        
+        if (stepIndex != automation.clockedStepIndex)
+        {
+            automation.clockedStepIndex = stepIndex;
+            onClockedOutput(automation.sliderIndex, grid.getStepValue(stepIndex));
+        }
+        
+        if (elapsed >= getTotalDuration(automation.params))
+            automation.hasClockedFinalValue = true;
+        else
+            automation.nextClockedStepTime = getNextOutputStep(automation, automation.clockedStepIndex, now).timeMs;
     }
 }
 
-void AutomationEngine::updateAutomation(SliderAutomation& automation)
+bool AutomationEngine::claimClockedFinalValue(SliderAutomation& automation)
+{
+    const juce::SpinLock::ScopedLockType lock(automationLock);
+    if (!automation.isClocked || automation.hasClockedFinalValue)
+        return false;
+    
+    automation.hasClockedFinalValue = true;
+    
+    // Nothing to send if the output already rests on the final step
+    int finalStep = automation.params.outputGrid.getStepIndex(getFinalValue(automation));
+    if (finalStep == automation.clockedStepIndex)
+        return false;
+    
+    automation.clockedStepIndex = finalStep;
+    return true;
+}
+
+//==============================================================================
+double AutomationEngine::getTotalDuration(const AutomationParams& params) const
+{
+    return params.delayTime + params.attackTime + juce::jmax(0.0, params.returnTime);
+}
+
+double AutomationEngine::getFinalValue(const SliderAutomation& automation) const
+{
+    // If we had a return phase, end at original value; otherwise end at target
+    return (automation.params.returnTime > 0.0) ? automation.originalValue : automation.params.targetValue;
+}
+
+double AutomationEngine::getElapsedAt(const SliderAutomation& automation, double timeMs) const
 {
-    double currentTime = juce::Time::getMillisecondCounterHiRes();
-    double elapsed = (currentTime - automation.startTime) / 1000.0; // Convert to seconds
+    if (automation.params.isBeatTimed)
+        return beatClock.getBeatAt(timeMs) - automation.startBeat;
     
+    return (timeMs - automation.startTime) / 1000.0;
+}
+
+double AutomationEngine::getTimeAtElapsed(const SliderAutomation& automation, double elapsed) const
+{
+    if (automation.params.isBeatTimed)
+        return beatClock.getTimeAt(automation.startBeat + elapsed);
+    
+    return automation.startTime + elapsed * 1000.0;
+}
+
+double AutomationEngine::calculateValueAt(const SliderAutomation& automation, double elapsed) const
+{
     const auto& params = automation.params;
     
     if (elapsed < params.delayTime)
     {
-        // DELAY PHASE: Still waiting, no action needed
-        return;
+        // DELAY PHASE: Hold the start value
+        return params.startValue;
     }
     else if (elapsed < params.delayTime + params.attackTime)
     {
         // ATTACK PHASE: Move from start to target with curve applied
         double attackElapsed = elapsed - params.delayTime;
         double progress = attackElapsed / params.attackTime;
-        double curvedProgress = applyCurve(progress, params.curveValue);
-        double currentValue = params.startValue + (params.targetValue - params.startValue) * curvedProgress;
-        
-        if (onValueUpdate)
-            onValueUpdate(automation.sliderIndex, currentValue);
+        double curvedProgress = automation.attackCurve->getValue(progress);
+        return params.startValue + (params.targetValue - params.startValue) * curvedProgress;
     }
-    else if (params.returnTime > 0.0 && elapsed < params.delayTime + params.attackTime + params.returnTime)
+    else if (params.returnTime > 0.0 && elapsed < getTotalDuration(params))
     {
         // RETURN PHASE: Move from target back to original
-        if (!automation.isInReturnPhase)
-        {
-            automation.isInReturnPhase = true;
-            DBG("AutomationEngine: Entering return phase for slider " << automation.sliderIndex);
-        }
-        
         double returnElapsed = elapsed - params.delayTime - params.attackTime;
         double progress = returnElapsed / params.returnTime;
-        // Create proper inverse curve: exponential becomes logarithmic and vice versa
-        double inverseCurve;
-        if (params.curveValue < 1.0)
+        double curvedProgress = automation.returnCurve->getValue(progress);
+        return params.targetValue + (automation.originalValue - params.targetValue) * curvedProgress;
+    }
+    
+    return getFinalValue(automation);
+}
+
+AutomationEngine::OutputStep AutomationEngine::getNextOutputStep(const SliderAutomation& automation, int stepIndex, double fromTime) const
+{
+    const auto& params = automation.params;
+    const auto& grid = params.outputGrid;
+    double attackStartTime = getTimeAtElapsed(automation, params.delayTime);
+    double attackEndTime = getTimeAtElapsed(automation, params.delayTime + params.attackTime);
+    double endTime = getTimeAtElapsed(automation, getTotalDuration(params));
+    
+    struct Phase {
+        double startTime, endTime, fromValue, toValue;
+        const CurveTable* curve;
+    };
+    const Phase phases[] = {
+        { attackStartTime, attackEndTime, params.startValue, params.targetValue, automation.attackCurve.get() },
+        { attackEndTime, endTime, params.targetValue, automation.originalValue, automation.returnCurve.get() }
+    };
+    int numPhases = params.returnTime > 0.0 ? 2 : 1;
+    
+    for (int i = 0; i < numPhases; ++i)
+    {
+        const auto& phase = phases[i];
+        if (phase.endTime <= fromTime || phase.toValue == phase.fromValue)
+            continue;
+        
+        // Fraction of the move at which the value leaves the step, then the progress at which
+        // the curve gets there: curve(p) = p^exponent, so p = fraction^(1 / exponent)
+        int direction = phase.toValue > phase.fromValue ? 1 : -1;
+        double fraction = (grid.getStepBoundary(stepIndex, direction) - phase.fromValue) / (phase.toValue - phase.fromValue);
+        if (fraction >= 1.0)
+            continue;   // Stays on this step for the whole phase
+        
+        double progress = fraction > 0.0 ? std::pow(fraction, 1.0 / phase.curve->getExponent()) : 0.0;
+        double crossingTime = phase.startTime + progress * (phase.endTime - phase.startTime);
+        
+        if (crossingTime > fromTime)
+            return { crossingTime, stepIndex + direction };
+        
+        // Already past the crossing - the output is due to move now
+        int currentStep = grid.getStepIndex(calculateValueAt(automation, getElapsedAt(automation, fromTime)));
+        return { fromTime, currentStep != stepIndex ? currentStep : stepIndex + direction };
+    }
+    
+    return { endTime, grid.getStepIndex(getFinalValue(automation)) };
+}
+
+void AutomationEngine::renderScheduledOutput(SliderAutomation& automation, double untilTime)
+{
+    const auto& params = automation.params;
+    const auto& grid = params.outputGrid;
+    double endTime = getTimeAtElapsed(automation, getTotalDuration(params));
+    
+    // Already rendered through to the final value
+    if (automation.scheduledUntil >= endTime && automation.scheduledStepIndex != NO_STEP)
+        return;
+    
+    double renderUntil = juce::jmin(untilTime, endTime);
+    double time = juce::jmin(automation.scheduledUntil, endTime);
+    
+    std::vector<ScheduledPoint> points;
+    
+    // After a clear, pick up from the current value (nothing is sent during the delay phase)
+    if (automation.scheduledStepIndex == NO_STEP)
+    {
+        double value = calculateValueAt(automation, getElapsedAt(automation, time));
+        automation.scheduledStepIndex = grid.getStepIndex(value);
+        
+        if (time >= getTimeAtElapsed(automation, params.delayTime))
         {
-            // Attack was exponential, return should be logarithmic
-            inverseCurve = 1.0 + (1.0 - params.curveValue); // Maps 0.0->2.0, 1.0->1.0
+            points.push_back({ time, value });
+            automation.lastScheduledTime = time;
         }
-        else if (params.curveValue > 1.0)
+    }
+    
+    // One point per step, at the exact time the curve crosses into it. Steps closer together
+    // than SCHEDULE_STEP_MS are merged into the value at the earliest allowed time.
+    for (;;)
+    {
+        auto step = getNextOutputStep(automation, automation.scheduledStepIndex, time);
+        double earliestTime = automation.lastScheduledTime + SCHEDULE_STEP_MS;
+        bool isExactStep = step.timeMs >= earliestTime;
+        double pointTime = isExactStep ? step.timeMs : earliestTime;
+        
+        if (pointTime > renderUntil || pointTime >= endTime)
+            break;
+        
+        // An exact step is sent as its step centre, so the slider's quantization keeps it
+        double value = isExactStep ? grid.getStepCentre(step.stepIndex)
+                                   : calculateValueAt(automation, getElapsedAt(automation, pointTime));
+        int stepIndex = isExactStep ? step.stepIndex : grid.getStepIndex(value);
+        time = pointTime;
+        
+        if (stepIndex != automation.scheduledStepIndex)
         {
-            // Attack was logarithmic, return should be exponential  
-            inverseCurve = 1.0 - (params.curveValue - 1.0); // Maps 2.0->0.0, 1.0->1.0
+            points.push_back({ pointTime, value });
+            automation.scheduledStepIndex = stepIndex;
+            automation.lastScheduledTime = pointTime;
         }
-        else
+    }
+    
+    if (renderUntil >= endTime)
+    {
+        // Land exactly on the final value at the exact end time
+        int finalStep = grid.getStepIndex(getFinalValue(automation));
+        if (finalStep != automation.scheduledStepIndex)
         {
-            // Attack was linear, return stays linear
-            inverseCurve = 1.0;
+            points.push_back({ endTime, getFinalValue(automation) });
+            automation.scheduledStepIndex = finalStep;
         }
-        double curvedProgress = applyCurve(progress, inverseCurve);
-        double currentValue = params.targetValue + (automation.originalValue - params.targetValue) * curvedProgress;
-        
-        if (onValueUpdate)
-            onValueUpdate(automation.sliderIndex, currentValue);
+        automation.scheduledUntil = endTime;
     }
     else
     {
-        // AUTOMATION COMPLETE
-        completeAutomation(automation);
+        automation.scheduledUntil = renderUntil;
     }
+    
+    if (!points.empty())
+        onScheduleOutput(automation.sliderIndex, points);
 }
 
-void AutomationEngine::completeAutomation(SliderAutomation& automation)
+bool AutomationEngine::updateAutomation(SliderAutomation& automation, double currentTime)
 {
-    // If we had a return phase, end at original value; otherwise end at target
-    double finalValue = (automation.params.returnTime > 0.0) ? automation.originalValue : automation.params.targetValue;
+    double elapsed = getElapsedAt(automation, currentTime); // Seconds, or beats
+    
+    const auto& params = automation.params;
+    
+    if (elapsed < params.delayTime)
+    {
+        // DELAY PHASE: Still waiting, no action needed
+        return false;
+    }
+    
+    if (elapsed < getTotalDuration(params))
+    {
+        // ATTACK / RETURN PHASE: Follow the curve
+        if (params.returnTime > 0.0 && elapsed >= params.delayTime + params.attackTime && !automation.isInReturnPhase)
+        {
+            automation.isInReturnPhase = true;
+            CORE_LOG_DEBUG("AutomationEngine", "Entering return phase for slider " << automation.sliderIndex);
+        }
+        
+        publishValue(automation, calculateValueAt(automation, elapsed));
+        return false;
+    }
     
-    if (onValueUpdate)
-        onValueUpdate(automation.sliderIndex, finalValue);
+    // AUTOMATION COMPLETE
+    double finalValue = getFinalValue(automation);
+    publishValue(automation, finalValue);
     
-    DBG("AutomationEngine: Completed automation for slider " << automation.sliderIndex 
+    CORE_LOG_DEBUG("AutomationEngine", "Completed automation for slider " << automation.sliderIndex 
         << " with final value " << finalValue);
+    return true;
+}
+
+void AutomationEngine::publishValue(SliderAutomation& automation, double value)
+{
+    // Only values that land on a new output step reach the sliders (and their MIDI output)
+    int stepIndex = automation.params.outputGrid.getStepIndex(value);
+    if (stepIndex == automation.publishedStepIndex)
+        return;
     
-    // Mark as inactive
-    automation.isActive = false;
-    automation.isInReturnPhase = false;
+    automation.publishedStepIndex = stepIndex;
+    pendingUpdates.push_back({ automation.sliderIndex, value });
+}
+
+//==============================================================================
+AutomationEngine::SliderAutomation* AutomationEngine::findAutomation(int sliderIndex)
+{
+    if (sliderIndex < 0 || sliderIndex >= NUM_SLIDERS || activeSlots[(size_t)sliderIndex] < 0)
+        return nullptr;
     
-    // Notify state change
-    if (onAutomationStateChanged)
-        onAutomationStateChanged(automation.sliderIndex, false);
+    return &automations[(size_t)activeSlots[(size_t)sliderIndex]];
 }
 
-bool AutomationEngine::hasAnyActiveAutomations() const
+const AutomationEngine::SliderAutomation* AutomationEngine::findAutomation(int sliderIndex) const
 {
-    for (const auto& automation : automations)
+    if (sliderIndex < 0 || sliderIndex >= NUM_SLIDERS || activeSlots[(size_t)sliderIndex] < 0)
+        return nullptr;
+    
+    return &automations[(size_t)activeSlots[(size_t)sliderIndex]];
+}
+
+bool AutomationEngine::removeAutomation(int sliderIndex)
+{
+    if (findAutomation(sliderIndex) == nullptr)
+        return false;
+    
+    // Keep the list compact: the last running automation takes the freed slot
+    const juce::SpinLock::ScopedLockType lock(automationLock);
+    int slot = activeSlots[(size_t)sliderIndex];
+    int last = --numActive;
+    if (slot != last)
     {
-        if (automation.isActive)
-            return true;
+        automations[(size_t)slot] = automations[(size_t)last];
+        activeSlots[(size_t)automations[(size_t)slot].sliderIndex] = slot;
     }
-    return false;
-}
\ No newline at end of file
+    
+    activeSlots[(size_t)sliderIndex] = -1;
+    return true;
+}
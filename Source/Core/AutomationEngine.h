@@ -2,15 +2,53 @@
 #include <JuceHeader.h>
 #include <functional>
 #include <array>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include "CurveTable.h"
 
 //==============================================================================
 /**
  * AutomationEngine handles complex delay/attack/return automation with curve calculations
  * Extracted from SimpleSliderControl to provide clean separation of concerns
+ *
+ * One engine drives every slider: running automations sit in a compact active list that a
+ * single timer ticks in one pass, publishing all new values together through onValuesUpdated.
+ * The timer only runs while something is automating.
+ *
+ * MIDI output comes from one of two places. With the output clock enabled, a high-resolution
+ * timer evaluates the curves at up to 500 Hz (MidiManager's output drain rate) on its own
+ * thread and hands quantized values to onClockedOutput, so output timing no longer depends on
+ * the message thread - the 16 ms timer is then just the GUI frame clock. Without it,
+ * onScheduleOutput pre-renders timestamped points.
+ *
+ * Either way a value goes out only when it lands on a new output grid step. The time the curve
+ * next leaves its step is solved from the curve's inverse, so pre-scheduled points sit exactly
+ * on step crossings and the output clock skips evaluation until the next one is due - a slow
+ * ramp costs as many messages as the steps it crosses.
+ *
+ * Beat-timed automations run on a beat clock instead of milliseconds, so a tempo change
+ * re-maps them in flight and their phases still end on the beats they were set to.
  */
 class AutomationEngine : public juce::Timer
 {
 public:
+    // The slider's output quantization as a grid: round(value / inputStep) * outputStep,
+    // clamped to 0-16383. Captured at start so the output clock never reads slider state.
+    // Output is only sent when a value lands on a different step.
+    struct OutputGrid {
+        double inputStep = 1.0;
+        double outputStep = 1.0;
+        
+        int getStepIndex(double value) const { return (int)std::round(value / inputStep); }
+        int getStepValue(int stepIndex) const { return juce::jlimit(0, 16383, juce::roundToInt(stepIndex * outputStep)); }
+        double getStepCentre(int stepIndex) const { return juce::jlimit(0.0, 16383.0, stepIndex * inputStep); }
+        double getStepBoundary(int stepIndex, int direction) const { return (stepIndex + 0.5 * direction) * inputStep; }
+        int apply(double value) const { return getStepValue(getStepIndex(value)); }
+    };
+    
     struct AutomationParams {
         double delayTime = 0.0;     // Delay before movement starts (seconds)
         double attackTime = 1.0;    // Time to move from start to target (seconds)
@@ -18,6 +56,25 @@ public:
         double curveValue = 1.0;    // Curve shape: 0.0-1.0 = exponential, 1.0 = linear, 1.0-2.0 = logarithmic
         double startValue = 0.0;    // Starting MIDI value (0-16383)
         double targetValue = 0.0;   // Target MIDI value (0-16383)
+        OutputGrid outputGrid;      // Quantization of output values (output is sent on step changes only)
+        bool isBeatTimed = false;   // Delay/attack/return are in beats (quarter notes) on the beat clock
+    };
+    
+    // Musical time for beat-timed automations: the beat position as a straight line through one
+    // (time, beat) anchor. The owner re-anchors it from its tempo source whenever that moves.
+    struct BeatClock {
+        double anchorTimeMs = 0.0;  // juce::Time::getMillisecondCounterHiRes() clock
+        double anchorBeat = 0.0;    // Quarter notes
+        double msPerBeat = 500.0;   // 120 BPM
+        
+        double getBeatAt(double timeMs) const { return anchorBeat + (timeMs - anchorTimeMs) / msPerBeat; }
+        double getTimeAt(double beat) const { return anchorTimeMs + (beat - anchorBeat) * msPerBeat; }
+    };
+    
+    // One slider's new value from a tick
+    struct ValueUpdate {
+        int sliderIndex = -1;
+        double value = 0.0;         // MIDI value (0-16383)
     };
     
     AutomationEngine();
@@ -32,36 +89,128 @@ public:
     // Manual override detection
     void handleManualOverride(int sliderIndex);
     
+    // Pre-scheduled output: when onScheduleOutput is set, upcoming curve segments are rendered
+    // LOOKAHEAD_MS ahead with absolute timestamps so the MIDI backend's clock sets the timing.
+    // onValuesUpdated then only drives the GUI for those sliders.
+    struct ScheduledPoint {
+        double timeMs = 0.0;        // Absolute time on the juce::Time::getMillisecondCounterHiRes() clock
+        double value = 0.0;         // MIDI value (0-16383)
+    };
+    void rescheduleOutput();        // Re-render all running automations from now (after a port-wide clear)
+    
+    // High-resolution output clock - 0 turns it off (output falls back to pre-scheduling).
+    // Automations keep the output mode they started with. Values clocked faster than the
+    // output queue is drained only overwrite each other, so pass at most its drain rate.
+    void setOutputClockRate(int hz);
+    int getOutputClockRate() const { return outputClockRateHz.load(std::memory_order_relaxed); }
+    
+    // True while the slider's MIDI output comes from the engine (clocked or pre-scheduled),
+    // so GUI value updates must not send it again
+    bool isOutputDrivenByEngine(int sliderIndex) const;
+    
+    // Beat-timed automations keep their position in beats across tempo changes: their remaining
+    // phases stretch or shrink to the new tempo and still end on the same beats. Output already
+    // timed at the old tempo is re-timed (pre-scheduled output through onScheduledOutputCancelled).
+    void setBeatClock(const BeatClock& newBeatClock);
+    const BeatClock& getBeatClock() const { return beatClock; }
+    
     // Callbacks for parent components
-    std::function<void(int sliderIndex, double newValue)> onValueUpdate;
+    std::function<void(const std::vector<ValueUpdate>& updates)> onValuesUpdated;
     std::function<void(int sliderIndex, bool isAutomating)> onAutomationStateChanged;
+    std::function<void(int sliderIndex, const std::vector<ScheduledPoint>& points)> onScheduleOutput;
+    std::function<void(int sliderIndex)> onScheduledOutputCancelled;
+    std::function<void(int sliderIndex, int value14bit)> onClockedOutput;  // Output clock thread - must not block
+    
+    static constexpr int NUM_SLIDERS = 16;
+    static constexpr int MIN_OUTPUT_CLOCK_HZ = 100;
+    static constexpr int MAX_OUTPUT_CLOCK_HZ = 500;       // MidiManager drains its output queue every 2 ms
+    static constexpr int DEFAULT_OUTPUT_CLOCK_HZ = 500;
     
 private:
-    // Internal automation state for each slider
+    // Internal automation state for one running slider
     struct SliderAutomation {
-        bool isActive = false;
         bool isInReturnPhase = false;
         double startTime = 0.0;
         double originalValue = 0.0;  // Value at start of automation (for return phase)
+        double startBeat = 0.0;      // Beat clock position at start (beat-timed automations)
         AutomationParams params;
         int sliderIndex = -1;
+        int publishedStepIndex = 0;  // Output grid step last published to the GUI
+        double scheduledUntil = 0.0; // Pre-scheduled output is rendered through this time (ms)
+        double lastScheduledTime = 0.0;
+        int scheduledStepIndex = 0;  // Step of the last pre-scheduled point, NO_STEP after a clear
+        int clockedStepIndex = 0;    // Step last sent by the output clock
+        double nextClockedStepTime = 0.0;  // The output clock has nothing to send before this (ms)
+        std::shared_ptr<const CurveTable> attackCurve;  // Shared lookup tables, immutable
+        std::shared_ptr<const CurveTable> returnCurve;
+        bool isClocked = false;      // Output comes from the output clock
+        bool hasClockedFinalValue = false;
+    };
+    
+    // Output clock - evaluates clocked automations off the message thread
+    class OutputClock : public juce::HighResolutionTimer
+    {
+    public:
+        explicit OutputClock(AutomationEngine& ownerToUse) : owner(ownerToUse) {}
+        ~OutputClock() override { stopTimer(); }
+        void hiResTimerCallback() override { owner.clockOutput(); }
+        
+    private:
+        AutomationEngine& owner;
     };
     
-    // Timer callback for automation updates
+    // Timer callback for automation updates (GUI frame clock when output is clocked)
     void timerCallback() override;
+    void clockOutput();             // Output clock thread
+    void updateOutputClock();       // Starts/stops the output clock with the clocked automations
+    bool isScheduled(const SliderAutomation& automation) const { return !automation.isClocked && onScheduleOutput != nullptr; }
+    
+    // When the output next leaves a grid step, from the exact curve inverse
+    struct OutputStep {
+        double timeMs = 0.0;
+        int stepIndex = 0;          // The step it moves to
+    };
+    OutputStep getNextOutputStep(const SliderAutomation& automation, int stepIndex, double fromTime) const;
+    bool claimClockedFinalValue(SliderAutomation& automation);
     
     // Internal processing methods
-    double applyCurve(double progress, double curveValue) const;
-    void updateAutomation(SliderAutomation& automation);
-    void completeAutomation(SliderAutomation& automation);
-    bool hasAnyActiveAutomations() const;
+    double getTotalDuration(const AutomationParams& params) const;
+    double getFinalValue(const SliderAutomation& automation) const;
+    double calculateValueAt(const SliderAutomation& automation, double elapsed) const;
+    
+    // Automation timeline (seconds, or beats for beat-timed automations) <-> clock time (ms)
+    double getElapsedAt(const SliderAutomation& automation, double timeMs) const;
+    double getTimeAtElapsed(const SliderAutomation& automation, double elapsed) const;
+    void renderScheduledOutput(SliderAutomation& automation, double untilTime);
+    bool updateAutomation(SliderAutomation& automation, double currentTime);
+    void publishValue(SliderAutomation& automation, double value);
+    
+    // Active list management
+    SliderAutomation* findAutomation(int sliderIndex);
+    const SliderAutomation* findAutomation(int sliderIndex) const;
+    bool removeAutomation(int sliderIndex);
     
     // Member variables
-    std::array<SliderAutomation, 16> automations;
+    std::array<SliderAutomation, NUM_SLIDERS> automations;  // [0, numActive) are running
+    std::array<int, NUM_SLIDERS> activeSlots;               // Slider index -> slot in automations, -1 when idle
+    int numActive = 0;
+    std::vector<ValueUpdate> pendingUpdates;                // One tick's batch, reused
+    
+    // The active list and the beat clock are changed under this lock; the output clock skips a
+    // tick rather than wait
+    juce::SpinLock automationLock;
+    BeatClock beatClock;
+    std::unique_ptr<OutputClock> outputClock;
+    std::atomic<int> outputClockRateHz { 0 };
     
     // Constants
     static constexpr int TIMER_INTERVAL = 16; // ~60fps updates
     static constexpr double MIN_VALUE_CHANGE = 1.0; // Minimum change to start automation
+    static constexpr double LOOKAHEAD_MS = 100.0; // How far ahead pre-scheduled output is rendered
+    static constexpr double SCHEDULE_STEP_MS = 2.0; // Minimum spacing of pre-scheduled points (500 Hz)
+    static constexpr int NO_STEP = std::numeric_limits<int>::min();
+    static constexpr double BEAT_CLOCK_TOLERANCE_MS = 0.5; // Beat clock moves smaller than this don't re-time output
+    static constexpr double MAX_PHASE_CORRECTION_BEATS = 0.25; // Larger beat clock jumps are transport relocations
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AutomationEngine)
 };
\ No newline at end of file
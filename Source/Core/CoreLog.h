@@ -0,0 +1,78 @@
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+ * CoreLog - leveled, compile-time filtered logging for the Core classes
+ *
+ * Usage mirrors DBG: CORE_LOG_DEBUG("MidiManager", "Opened " << deviceName);
+ * Messages below CORE_LOG_LEVEL are discarded by the compiler - the streamed
+ * arguments are type-checked but never evaluated, so a filtered call costs nothing
+ * (no String building, no allocation) in any build configuration.
+ *
+ * Per-event messages on the MIDI hot paths use Trace, which is off by default even
+ * in debug builds. Build with CORE_LOG_LEVEL=0 to see them.
+ */
+namespace CoreLog
+{
+    enum Level
+    {
+        Trace = 0,      // Per-event detail on hot paths
+        Debug = 1,      // State changes, device and mapping events
+        Info = 2,
+        Warning = 3,
+        Error = 4,
+        Off = 5
+    };
+
+   #ifndef CORE_LOG_LEVEL
+    #if JUCE_DEBUG
+     #define CORE_LOG_LEVEL 1
+    #else
+     #define CORE_LOG_LEVEL 3
+    #endif
+   #endif
+
+    constexpr bool isEnabled(int level) noexcept { return level >= CORE_LOG_LEVEL; }
+
+    inline const char* getLevelName(int level) noexcept
+    {
+        switch (level)
+        {
+            case Trace:   return "TRACE";
+            case Debug:   return "DEBUG";
+            case Info:    return "INFO";
+            case Warning: return "WARN";
+            case Error:   return "ERROR";
+            default:      return "";
+        }
+    }
+
+    inline void write(int level, const char* category, const juce::String& message)
+    {
+        juce::String line;
+        line << "[" << getLevelName(level) << "] " << category << ": " << message;
+
+        // Warnings and errors reach the application log; the rest only the debugger
+        if (level >= Warning)
+            juce::Logger::writeToLog(line);
+        else
+            juce::Logger::outputDebugString(line);
+    }
+}
+
+#define CORE_LOG(level, category, textToWrite) \
+    do { \
+        if constexpr (CoreLog::isEnabled(level)) \
+        { \
+            juce::String coreLogMessage; \
+            coreLogMessage << textToWrite; \
+            CoreLog::write(level, category, coreLogMessage); \
+        } \
+    } while (false)
+
+#define CORE_LOG_TRACE(category, textToWrite)   CORE_LOG(CoreLog::Trace, category, textToWrite)
+#define CORE_LOG_DEBUG(category, textToWrite)   CORE_LOG(CoreLog::Debug, category, textToWrite)
+#define CORE_LOG_INFO(category, textToWrite)    CORE_LOG(CoreLog::Info, category, textToWrite)
+#define CORE_LOG_WARNING(category, textToWrite) CORE_LOG(CoreLog::Warning, category, textToWrite)
+#define CORE_LOG_ERROR(category, textToWrite)   CORE_LOG(CoreLog::Error, category, textToWrite)
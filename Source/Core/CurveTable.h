@@ -0,0 +1,194 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+#include <memory>
+
+//==============================================================================
+/**
+ * CurveTable replaces std::pow(progress, exponent) for one automation curve with a fixed-size
+ * lookup table and linear interpolation. Convex curves (exponent >= 1) are tabulated directly
+ * over progress. Concave ones are tabulated over s = progress^(1/4), where they become convex
+ * power curves too - a uniform grid in progress could not follow their infinite slope at 0.
+ *
+ * The table knows its own accuracy: on each segment the largest gap between the chord and
+ * the power curve sits where the curve's slope equals the chord's, so the maximum error is
+ * computed exactly at build time. getMaxError() adds the float storage rounding on top and
+ * is a hard bound on |getValue(p) - pow(p, exponent)| over 0-1.
+ */
+class CurveTable
+{
+public:
+    explicit CurveTable(double exponentToUse)
+        : exponent(exponentToUse),
+          isLinear(exponentToUse == 1.0),
+          isRootDomain(exponentToUse < 1.0)
+    {
+        // The tabulated function is s^power over s in 0-1 in either domain
+        double power = isRootDomain ? exponent * ROOT_DOMAIN_POWER : exponent;
+        double step = 1.0 / TABLE_SIZE;
+
+        for (int i = 0; i <= TABLE_SIZE; ++i)
+            values[(size_t)i] = (float)std::pow(i * step, power);
+
+        if (!isLinear)
+            maxError = getMaxInterpolationError(power, step) + FLOAT_STORAGE_ERROR;
+    }
+
+    // Curved progress for linear progress (clamped to 0-1)
+    double getValue(double progress) const noexcept
+    {
+        progress = juce::jlimit(0.0, 1.0, progress);
+        if (isLinear)
+            return progress;
+
+        double position = (isRootDomain ? std::sqrt(std::sqrt(progress)) : progress) * TABLE_SIZE;
+        int index = juce::jmin((int)position, TABLE_SIZE - 1);
+        double fraction = position - index;
+        return values[(size_t)index] + (values[(size_t)index + 1] - values[(size_t)index]) * fraction;
+    }
+
+    double getExponent() const noexcept { return exponent; }
+    double getMaxError() const noexcept { return maxError; }
+
+    // Curve knob value (0.0-1.0 exponential, 1.0 linear, 1.0-2.0 logarithmic) to its exponent
+    static double getExponentForCurve(double curveValue) noexcept
+    {
+        curveValue = juce::jlimit(0.0, 2.0, curveValue);
+
+        if (curveValue < 1.0)
+            return 1.0 + (1.0 - curveValue) * 3.0;          // Range: 1.0 to 4.0
+        if (curveValue > 1.0)
+            return 1.0 / (1.0 + (curveValue - 1.0) * 3.0);  // Range: 1.0 to 0.25
+        return 1.0;
+    }
+
+    // Return phase curve: exponential becomes logarithmic and vice versa (maps 0.0<->2.0)
+    static double getInverseCurve(double curveValue) noexcept
+    {
+        return 2.0 - curveValue;
+    }
+
+    static constexpr int TABLE_SIZE = 1024;
+
+private:
+    // Largest |chord - s^power| over all table segments
+    static double getMaxInterpolationError(double power, double step)
+    {
+        double largest = 0.0;
+
+        for (int i = 0; i < TABLE_SIZE; ++i)
+        {
+            double s0 = i * step;
+            double s1 = s0 + step;
+            double f0 = std::pow(s0, power);
+            double slope = (std::pow(s1, power) - f0) / step;
+
+            // power * s^(power - 1) == slope
+            double extremum = juce::jlimit(s0, s1, std::pow(slope / power, 1.0 / (power - 1.0)));
+            largest = juce::jmax(largest, std::abs(f0 + slope * (extremum - s0) - std::pow(extremum, power)));
+        }
+
+        return largest;
+    }
+
+    static constexpr double ROOT_DOMAIN_POWER = 4.0;        // progress = s^4
+    static constexpr double FLOAT_STORAGE_ERROR = 1.0e-7;   // Float rounding of values in 0-1, with margin
+
+    std::array<float, TABLE_SIZE + 1> values;
+    double exponent = 1.0;
+    bool isLinear = true;
+    bool isRootDomain = false;
+    double maxError = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CurveTable)
+};
+
+//==============================================================================
+/**
+ * CurveTableCache shares CurveTables between everything that evaluates automation curves -
+ * the automation engine and the curve visualizer. Tables are keyed by their exponent rounded
+ * to 1/EXPONENT_STEPS, so knob values that differ only by rounding noise share a table; that
+ * moves a curve by less than 1.2e-5 (a fifth of a 14-bit step). The few most recent are kept.
+ *
+ * Tables are immutable once built: a holder of the shared_ptr (e.g. an automation evaluated
+ * on the output clock thread) reads it without locking, and an evicted table lives on until
+ * its last holder lets go. The cache itself is guarded by a SpinLock, which is never held
+ * while a table is built. Fetch a table once and evaluate it directly - the cache is for
+ * starting an automation or laying out a curve, not for every point.
+ */
+class CurveTableCache
+{
+public:
+    static CurveTableCache& getInstance()
+    {
+        static CurveTableCache instance;
+        return instance;
+    }
+
+    std::shared_ptr<const CurveTable> getTableForCurve(double curveValue)
+    {
+        return getTable(CurveTable::getExponentForCurve(curveValue));
+    }
+
+    std::shared_ptr<const CurveTable> getTable(double exponent)
+    {
+        exponent = getCacheKey(exponent);
+
+        {
+            const juce::SpinLock::ScopedLockType lock(cacheLock);
+            if (auto table = findTable(exponent))
+                return table;
+        }
+
+        // Tabulate without the lock so other callers aren't held up meanwhile
+        auto table = std::make_shared<const CurveTable>(exponent);
+
+        const juce::SpinLock::ScopedLockType lock(cacheLock);
+
+        // Someone else may have built the same table in the meantime - share theirs
+        if (auto existing = findTable(exponent))
+            return existing;
+
+        // Evict the oldest entry
+        tables[(size_t)nextSlot] = table;
+        nextSlot = (nextSlot + 1) % MAX_CACHED_TABLES;
+        return table;
+    }
+
+    // The exponent a table is actually built for
+    static double getCacheKey(double exponent) noexcept
+    {
+        return std::round(exponent * EXPONENT_STEPS) / EXPONENT_STEPS;
+    }
+
+    // One-off evaluation - callers with many points should hold on to the table instead
+    double applyCurve(double progress, double curveValue)
+    {
+        return getTableForCurve(curveValue)->getValue(progress);
+    }
+
+    static constexpr int MAX_CACHED_TABLES = 32;    // 16 sliders, attack and return curves
+    static constexpr double EXPONENT_STEPS = 65536.0;
+
+private:
+    CurveTableCache() = default;
+
+    // Caller holds cacheLock
+    std::shared_ptr<const CurveTable> findTable(double exponent) const
+    {
+        for (const auto& table : tables)
+        {
+            if (table != nullptr && table->getExponent() == exponent)
+                return table;
+        }
+
+        return nullptr;
+    }
+
+    std::array<std::shared_ptr<const CurveTable>, MAX_CACHED_TABLES> tables;
+    int nextSlot = 0;
+    juce::SpinLock cacheLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CurveTableCache)
+};
@@ -208,18 +208,12 @@ void KeyboardController::processKeyboardMovement()
     {
         if (mapping.isPressed)
         {
-            // Check if slider is locked using callback
-            bool sliderIsLocked = false;
-            if (isSliderLocked)
-                sliderIsLocked = isSliderLocked(mapping.currentSliderIndex);
+            auto sliderState = sliderStateStore != nullptr ? sliderStateStore->getState(mapping.currentSliderIndex)
+                                                           : SliderStateStore::SliderState();
                 
-            if (!sliderIsLocked)
+            if (!sliderState.isLocked)
             {
-                // Get current slider value using callback
-                double currentValue = 0.0;
-                if (getSliderValue)
-                    currentValue = getSliderValue(mapping.currentSliderIndex);
-                    
+                double currentValue = (double)sliderState.value14bit;
                 double newValue = currentValue;
                 
                 // Handle instant movement (100%)
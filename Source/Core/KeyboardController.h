@@ -2,6 +2,7 @@
 #include <JuceHeader.h>
 #include <vector>
 #include <functional>
+#include "SliderStateStore.h"
 
 //==============================================================================
 /**
@@ -30,11 +31,12 @@ public:
     // State queries
     bool isTextInputActive() const;
     
+    // Slider values and lock flags are read from the shared store
+    void setSliderStateStore(const SliderStateStore* store) { sliderStateStore = store; }
+    
     // Callbacks for parent components
     std::function<void(int sliderIndex, double newValue)> onSliderValueChanged;
     std::function<void(const juce::String&)> onSpeedDisplayChanged;
-    std::function<bool(int sliderIndex)> isSliderLocked; // Check if slider is locked
-    std::function<double(int sliderIndex)> getSliderValue; // Get current slider value
     std::function<int(int keyboardPosition)> getVisibleSliderIndex; // Map keyboard position to slider index
     
 private:
@@ -57,6 +59,7 @@ private:
     };
     
     // Member variables
+    const SliderStateStore* sliderStateStore = nullptr;
     std::vector<KeyboardMapping> keyboardMappings;
     std::vector<int> movementRates;
     int currentRateIndex = 2;
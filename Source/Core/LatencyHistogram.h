@@ -0,0 +1,129 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+//==============================================================================
+/**
+ * LatencyHistogram records durations in microseconds into log-linear buckets, HDR
+ * histogram style: exact below 32 us, then 16 linear sub-buckets per power of two, so
+ * any recorded value is reported within ~6% at a fixed 368 counters (up to ~67 s).
+ *
+ * record() is wait-free and can be called from any number of threads; readers see
+ * relaxed counts, so a percentile taken while recording may be off by the handful of
+ * values in flight. Values above the range land in the last bucket; the exact maximum
+ * is tracked separately.
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram() { reset(); }
+
+    void record(uint64_t microseconds) noexcept
+    {
+        counts[(size_t)getBucketIndex(microseconds)].fetch_add(1, std::memory_order_relaxed);
+        totalCount.fetch_add(1, std::memory_order_relaxed);
+        totalMicroseconds.fetch_add(microseconds, std::memory_order_relaxed);
+
+        uint64_t previousMax = maxMicroseconds.load(std::memory_order_relaxed);
+        while (microseconds > previousMax
+               && !maxMicroseconds.compare_exchange_weak(previousMax, microseconds, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void recordMilliseconds(double milliseconds) noexcept
+    {
+        record(milliseconds > 0.0 ? (uint64_t)(milliseconds * 1000.0 + 0.5) : 0);
+    }
+
+    // Value at or below which the given percentage (0-100) of samples fall - reported as
+    // the upper edge of its bucket, never above the recorded maximum. 0 when empty.
+    uint64_t getPercentile(double percentile) const noexcept
+    {
+        std::array<uint64_t, NUM_BUCKETS> snapshot;
+        uint64_t total = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; ++i)
+        {
+            snapshot[i] = counts[i].load(std::memory_order_relaxed);
+            total += snapshot[i];
+        }
+
+        if (total == 0)
+            return 0;
+
+        auto rank = (uint64_t)std::ceil(juce::jlimit(0.0, 100.0, percentile) / 100.0 * (double)total);
+        rank = juce::jlimit((uint64_t)1, total, rank);
+
+        uint64_t maximum = getMax();
+        uint64_t seen = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; ++i)
+        {
+            seen += snapshot[i];
+            if (seen >= rank)
+                return juce::jmin(getBucketUpperBound((int)i), maximum);
+        }
+        return maximum;
+    }
+
+    uint64_t getCount() const noexcept { return totalCount.load(std::memory_order_relaxed); }
+    uint64_t getMax() const noexcept   { return maxMicroseconds.load(std::memory_order_relaxed); }
+
+    double getMean() const noexcept
+    {
+        uint64_t count = getCount();
+        return count > 0 ? (double)totalMicroseconds.load(std::memory_order_relaxed) / (double)count : 0.0;
+    }
+
+    // Not synchronised with record() - values recorded during a reset may survive it
+    void reset() noexcept
+    {
+        for (auto& count : counts)
+            count.store(0, std::memory_order_relaxed);
+        totalCount.store(0, std::memory_order_relaxed);
+        totalMicroseconds.store(0, std::memory_order_relaxed);
+        maxMicroseconds.store(0, std::memory_order_relaxed);
+    }
+
+    static constexpr int SUB_BUCKETS = 16;             // Per power of two above LINEAR_LIMIT
+    static constexpr int LINEAR_LIMIT = 2 * SUB_BUCKETS;
+    static constexpr int MAX_EXPONENT = 21;            // Highest shift - values up to 2^26 us
+    static constexpr int NUM_BUCKETS = LINEAR_LIMIT + MAX_EXPONENT * SUB_BUCKETS;
+
+    static int getBucketIndex(uint64_t value) noexcept
+    {
+        if (value < (uint64_t)LINEAR_LIMIT)
+            return (int)value;
+
+        int highestBit = 63;
+        while ((value >> highestBit) == 0)
+            --highestBit;
+
+        int shift = highestBit - 4;
+        if (shift > MAX_EXPONENT)
+            return NUM_BUCKETS - 1;
+
+        int subBucket = (int)(value >> shift) - SUB_BUCKETS;
+        return LINEAR_LIMIT + (shift - 1) * SUB_BUCKETS + subBucket;
+    }
+
+    static uint64_t getBucketUpperBound(int index) noexcept
+    {
+        if (index < LINEAR_LIMIT)
+            return (uint64_t)index;
+
+        int shift = (index - LINEAR_LIMIT) / SUB_BUCKETS + 1;
+        int subBucket = (index - LINEAR_LIMIT) % SUB_BUCKETS + SUB_BUCKETS;
+        return ((uint64_t)(subBucket + 1) << shift) - 1;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> counts;
+    std::atomic<uint64_t> totalCount { 0 };
+    std::atomic<uint64_t> totalMicroseconds { 0 };
+    std::atomic<uint64_t> maxMicroseconds { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LatencyHistogram)
+};
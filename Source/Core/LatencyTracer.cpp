@@ -0,0 +1,144 @@
+#include "LatencyTracer.h"
+#include "CoreLog.h"
+
+namespace
+{
+    // The trace open on this thread - the stamps of one event all run on the thread that
+    // dispatched it, so no locking is needed
+    struct TraceContext
+    {
+        bool isOpen = false;
+        double inputTimeMs = 0.0;
+        double dispatchTimeMs = 0.0;
+        double sliderTimeMs = 0.0;
+        bool hasDispatch = false;
+        bool hasSlider = false;
+        bool hasSend = false;
+    };
+
+    thread_local TraceContext currentTrace;
+}
+
+//==============================================================================
+void LatencyTracer::beginTrace(double inputTimeMs)
+{
+    currentTrace = {};
+    currentTrace.isOpen = isEnabled();
+    currentTrace.inputTimeMs = inputTimeMs;
+}
+
+void LatencyTracer::markDispatch()
+{
+    if (!currentTrace.isOpen || currentTrace.hasDispatch)
+        return;
+
+    currentTrace.dispatchTimeMs = juce::Time::getMillisecondCounterHiRes();
+    currentTrace.hasDispatch = true;
+    record(InputToDispatch, currentTrace.inputTimeMs, currentTrace.dispatchTimeMs);
+}
+
+void LatencyTracer::markSliderUpdate()
+{
+    if (!currentTrace.isOpen || !currentTrace.hasDispatch || currentTrace.hasSlider)
+        return;
+
+    currentTrace.sliderTimeMs = juce::Time::getMillisecondCounterHiRes();
+    currentTrace.hasSlider = true;
+    record(DispatchToSlider, currentTrace.dispatchTimeMs, currentTrace.sliderTimeMs);
+}
+
+void LatencyTracer::markSend()
+{
+    if (!currentTrace.isOpen || !currentTrace.hasSlider || currentTrace.hasSend)
+        return;
+
+    double now = juce::Time::getMillisecondCounterHiRes();
+    currentTrace.hasSend = true;
+    record(SliderToSend, currentTrace.sliderTimeMs, now);
+    record(InputToSend, currentTrace.inputTimeMs, now);
+}
+
+void LatencyTracer::endTrace()
+{
+    currentTrace.isOpen = false;
+}
+
+void LatencyTracer::record(Stage stage, double fromMs, double toMs)
+{
+    histograms[(size_t)stage].recordMilliseconds(toMs - fromMs);
+}
+
+//==============================================================================
+const char* LatencyTracer::getStageName(Stage stage)
+{
+    switch (stage)
+    {
+        case InputToDispatch:  return "Input->Dispatch";
+        case DispatchToSlider: return "Dispatch->Slider";
+        case SliderToSend:     return "Slider->Send";
+        case InputToSend:      return "Input->Send";
+        default:               return "";
+    }
+}
+
+juce::String LatencyTracer::getSummaryText() const
+{
+    auto toMs = [](uint64_t microseconds) { return juce::String((double)microseconds / 1000.0, 2); };
+
+    juce::StringArray stages;
+    for (int i = 0; i < NumStages; ++i)
+    {
+        const auto& histogram = histograms[(size_t)i];
+        if (histogram.getCount() == 0)
+            continue;
+
+        stages.add(juce::String(getStageName((Stage)i)) + " " + toMs(histogram.getPercentile(50.0))
+                   + "/" + toMs(histogram.getPercentile(99.0))
+                   + "/" + toMs(histogram.getPercentile(99.9))
+                   + "/" + toMs(histogram.getMax()));
+    }
+
+    if (stages.isEmpty())
+        return "Latency: no samples";
+
+    return "Latency ms (p50/p99/p99.9/max): " + stages.joinIntoString("  ");
+}
+
+juce::String LatencyTracer::exportCsv() const
+{
+    juce::String csv;
+    csv << "stage,count,mean_us,p50_us,p90_us,p99_us,p99_9_us,max_us\n";
+
+    for (int i = 0; i < NumStages; ++i)
+    {
+        const auto& histogram = histograms[(size_t)i];
+        csv << getStageName((Stage)i) << ","
+            << (juce::int64)histogram.getCount() << ","
+            << juce::String(histogram.getMean(), 1) << ","
+            << (juce::int64)histogram.getPercentile(50.0) << ","
+            << (juce::int64)histogram.getPercentile(90.0) << ","
+            << (juce::int64)histogram.getPercentile(99.0) << ","
+            << (juce::int64)histogram.getPercentile(99.9) << ","
+            << (juce::int64)histogram.getMax() << "\n";
+    }
+
+    return csv;
+}
+
+bool LatencyTracer::exportCsv(const juce::File& file) const
+{
+    if (!file.replaceWithText(exportCsv()))
+    {
+        CORE_LOG_WARNING("LatencyTracer", "Failed to write " << file.getFullPathName());
+        return false;
+    }
+
+    CORE_LOG_DEBUG("LatencyTracer", "Exported latency histograms to " << file.getFullPathName());
+    return true;
+}
+
+void LatencyTracer::reset()
+{
+    for (auto& histogram : histograms)
+        histogram.reset();
+}
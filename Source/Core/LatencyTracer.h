@@ -0,0 +1,66 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "LatencyHistogram.h"
+
+//==============================================================================
+/**
+ * LatencyTracer measures how long an incoming controller takes to travel through the app.
+ * Each event is stamped when it arrives (handleIncomingMidiMessage), when Midi7BitController
+ * resolves its target, when the slider takes the value and when the resulting 14-bit value
+ * is handed to the output queue; the gaps go into one LatencyHistogram per stage.
+ *
+ * MidiManager opens a trace around each event it dispatches and the later stamps attach to
+ * the trace open on the calling thread, so no state is passed along the call chain. Stamps
+ * with no open trace (a mouse drag, automation) are ignored, and each stage is recorded at
+ * most once per event. Only synchronous chains produce the later stages - Direct mode input
+ * never sends, so its traces end at the slider.
+ */
+class LatencyTracer
+{
+public:
+    enum Stage
+    {
+        InputToDispatch = 0,    // MIDI thread arrival -> target resolved on the message thread
+        DispatchToSlider,       // Target resolved -> slider value set
+        SliderToSend,           // Slider value set -> output queued
+        InputToSend,            // End to end
+        NumStages
+    };
+
+    static LatencyTracer& getInstance()
+    {
+        static LatencyTracer instance;
+        return instance;
+    }
+
+    // Tracing is cheap (one clock read and a few relaxed increments per stamp) and on by default
+    void setEnabled(bool shouldTrace) { enabled.store(shouldTrace, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Stamps - called on the thread that handles the event
+    void beginTrace(double inputTimeMs);
+    void markDispatch();
+    void markSliderUpdate();
+    void markSend();
+    void endTrace();
+
+    // Readers (any thread)
+    const LatencyHistogram& getHistogram(Stage stage) const { return histograms[(size_t)stage]; }
+    static const char* getStageName(Stage stage);
+    juce::String getSummaryText() const;   // One line, p50/p99/p99.9/max per stage in ms
+    juce::String exportCsv() const;
+    bool exportCsv(const juce::File& file) const;
+    void reset();
+
+private:
+    LatencyTracer() = default;
+
+    void record(Stage stage, double fromMs, double toMs);
+
+    std::array<LatencyHistogram, NumStages> histograms;
+    std::atomic<bool> enabled { true };
+
+    JUCE_DECLARE_NON_COPYABLE(LatencyTracer)
+};
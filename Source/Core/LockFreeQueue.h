@@ -0,0 +1,99 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+/**
+ * LockFreeQueue is a fixed-capacity lock-free ring carrying trivially copyable items from
+ * any number of producer threads to a single consumer thread. Producers never block or
+ * allocate: a full queue drops the item and counts it.
+ * Bounded MPSC design after Dmitry Vyukov's sequenced ring buffer.
+ */
+template <typename ItemType, size_t CAPACITY>
+class LockFreeQueue
+{
+public:
+    LockFreeQueue()
+    {
+        for (size_t i = 0; i < CAPACITY; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Producer side - safe from any thread, never blocks
+    bool push(const ItemType& item) noexcept
+    {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& cell = cells[pos & INDEX_MASK];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto difference = (intptr_t)sequence - (intptr_t)pos;
+
+            if (difference == 0)
+            {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.item = item;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                // Queue full - drop rather than wait for the consumer
+                droppedItems.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer side - one thread only
+    bool pop(ItemType& item) noexcept
+    {
+        auto& cell = cells[dequeuePos & INDEX_MASK];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+        if ((intptr_t)sequence - (intptr_t)(dequeuePos + 1) < 0)
+            return false; // Empty
+
+        item = cell.item;
+        cell.sequence.store(dequeuePos + CAPACITY, std::memory_order_release);
+        ++dequeuePos;
+        return true;
+    }
+
+    // Consumer side - true if the next pop() would find nothing
+    bool isEmpty() const noexcept
+    {
+        size_t sequence = cells[dequeuePos & INDEX_MASK].sequence.load(std::memory_order_acquire);
+        return (intptr_t)sequence - (intptr_t)(dequeuePos + 1) < 0;
+    }
+
+    uint64_t getDroppedEventCount() const noexcept { return droppedItems.load(std::memory_order_relaxed); }
+
+    static constexpr size_t getCapacity() noexcept { return CAPACITY; }
+
+private:
+    static constexpr size_t INDEX_MASK = CAPACITY - 1;
+    static_assert(CAPACITY > 0 && (CAPACITY & INDEX_MASK) == 0, "LockFreeQueue capacity must be a power of two");
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence { 0 };
+        ItemType item;
+    };
+
+    std::array<Cell, CAPACITY> cells;
+    alignas(64) std::atomic<size_t> enqueuePos { 0 };
+    alignas(64) size_t dequeuePos = 0;
+    std::atomic<uint64_t> droppedItems { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(LockFreeQueue)
+};
@@ -0,0 +1,240 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+/**
+ * Midi14BitDecoder pairs incoming controller MSBs (CC 0-31) with their LSBs (CC 32-63)
+ * and emits exactly one combined 14-bit value per pair. It runs on the MIDI callback
+ * thread, keeps its pairing state in a flat (channel, controller) table and works from
+ * the messages' own timestamps, so scheduling jitter never splits a pair.
+ *
+ * Both send orders pair. A controller's order is taken from the half it sends first:
+ * MIDI 1.0 senders lead with the MSB, some controllers lead with the LSB. Once a
+ * controller has sent both halves, the leading half is held until its partner arrives
+ * (MSB-first: MSBs wait for their LSB; LSB-first: LSBs wait for their MSB). Until then
+ * an MSB goes out at once as a 7-bit value and an LSB as a 7-bit CC 32-63 of its own -
+ * an LSB is never merged into an MSB that was already emitted. Controllers that never
+ * send the other half pass straight through, and CCs 64-127 are never paired.
+ *
+ * Held halves whose partner never arrives are released after PAIR_TIMEOUT_MS by
+ * flushExpired(), which the owner calls from its frame clock: an MSB with its LSB taken
+ * as zero, an LSB as its own 7-bit CC. A spin lock guards the table against that flush;
+ * the MIDI thread holds it only for one table update and the flush never waits.
+ * The owner only feeds the decoder when 14-bit input decoding is switched on.
+ */
+class Midi14BitDecoder
+{
+public:
+    struct DecodedValue
+    {
+        int channel = 1;
+        int ccNumber = 0;           // MSB controller number for pairs
+        int value14bit = 0;
+        bool isHighResolution = false;
+        double timeMs = 0.0;        // Timestamp of the message that completed the value
+    };
+
+    Midi14BitDecoder() = default;
+
+    // Feed one controller message (MIDI thread). emit(const DecodedValue&) is called
+    // zero to two times (a stale held half is released ahead of the new message).
+    template <typename EmitFunction>
+    void process(int channel, int ccNumber, int value, double timeMs, EmitFunction&& emit)
+    {
+        if (channel < 1 || channel > 16 || !juce::isPositiveAndBelow(ccNumber, 128))
+            return;
+
+        if (ccNumber >= 64)
+        {
+            emit(DecodedValue { channel, ccNumber, (value & 0x7F) << 7, false, timeMs });
+            return;
+        }
+
+        const juce::SpinLock::ScopedLockType lock(stateLock);
+
+        int msbNumber = ccNumber & 0x1F;
+        auto& pair = pairStates[(size_t)((channel - 1) * 32 + msbNumber)];
+
+        if (ccNumber < 32)
+            processMsb(pair, channel, msbNumber, value & 0x7F, timeMs, emit);
+        else
+            processLsb(pair, channel, msbNumber, value & 0x7F, timeMs, emit);
+    }
+
+    // Release held halves that have waited longer than PAIR_TIMEOUT_MS (any thread).
+    // Skipped if the MIDI thread is mid-update - the next frame picks them up.
+    template <typename EmitFunction>
+    void flushExpired(double nowMs, EmitFunction&& emit)
+    {
+        if (numPendingHalves.load(std::memory_order_relaxed) == 0)
+            return;
+
+        const juce::SpinLock::ScopedTryLockType lock(stateLock);
+        if (!lock.isLocked())
+            return;
+
+        for (int i = 0; i < NUM_PAIRS; ++i)
+        {
+            auto& pair = pairStates[(size_t)i];
+            int channel = i / 32 + 1;
+            int msbNumber = i % 32;
+
+            if (pair.hasPendingMsb && nowMs - pair.msbTime > PAIR_TIMEOUT_MS)
+                releasePendingMsb(pair, channel, msbNumber, emit);
+
+            if (pair.hasPendingLsb && nowMs - pair.lsbTime > PAIR_TIMEOUT_MS)
+                releasePendingLsb(pair, channel, msbNumber, emit);
+        }
+    }
+
+    // Forget all pairing state (e.g. when the input device changes)
+    void reset()
+    {
+        const juce::SpinLock::ScopedLockType lock(stateLock);
+        pairStates.fill({});
+        numPendingHalves = 0;
+    }
+
+    // Statistics (any thread)
+    uint64_t getPairedValueCount() const { return pairedValues.load(std::memory_order_relaxed); }
+    uint64_t getUnpairedValueCount() const { return unpairedValues.load(std::memory_order_relaxed); }
+    uint64_t getStandaloneLsbCount() const { return standaloneLsbs.load(std::memory_order_relaxed); }
+
+    static constexpr double PAIR_TIMEOUT_MS = 20.0;   // A DIN pair is ~1.3 ms apart; USB bursts arrive together
+
+private:
+    struct PairState
+    {
+        double msbTime = 0.0;
+        double lsbTime = 0.0;
+        int msb = 0;
+        int lsb = 0;
+        bool hasPendingMsb = false;
+        bool hasPendingLsb = false;
+        bool sendsMsb = false;      // Sender has been seen sending this controller's MSB
+        bool sendsLsb = false;      // ... and its LSB
+        bool isLsbFirst = false;    // The first half seen was the LSB
+    };
+
+    template <typename EmitFunction>
+    void processMsb(PairState& pair, int channel, int msbNumber, int msb, double timeMs, EmitFunction&& emit)
+    {
+        if (!pair.sendsMsb && !pair.sendsLsb)
+            pair.isLsbFirst = false;
+        pair.sendsMsb = true;
+
+        if (pair.hasPendingLsb)
+        {
+            if (timeMs - pair.lsbTime <= PAIR_TIMEOUT_MS)
+            {
+                clearPendingLsb(pair);
+                pairedValues.fetch_add(1, std::memory_order_relaxed);
+                emit(DecodedValue { channel, msbNumber, (msb << 7) | pair.lsb, true, timeMs });
+                return;
+            }
+
+            // Too late to pair - release the LSB the frame clock hasn't flushed yet
+            releasePendingLsb(pair, channel, msbNumber, emit);
+        }
+
+        if (pair.sendsLsb && !pair.isLsbFirst)
+        {
+            // Hold until the LSB completes the pair. A newer MSB replaces one still
+            // waiting, so only the latest value is emitted.
+            if (!pair.hasPendingMsb)
+                numPendingHalves.fetch_add(1, std::memory_order_relaxed);
+
+            pair.msb = msb;
+            pair.msbTime = timeMs;
+            pair.hasPendingMsb = true;
+            return;
+        }
+
+        // 7-bit sender, or an LSB-first sender whose LSB didn't come (taken as zero)
+        unpairedValues.fetch_add(1, std::memory_order_relaxed);
+        emit(DecodedValue { channel, msbNumber, msb << 7, pair.sendsLsb, timeMs });
+    }
+
+    template <typename EmitFunction>
+    void processLsb(PairState& pair, int channel, int msbNumber, int lsb, double timeMs, EmitFunction&& emit)
+    {
+        if (!pair.sendsMsb && !pair.sendsLsb)
+            pair.isLsbFirst = true;
+        pair.sendsLsb = true;
+
+        if (pair.hasPendingMsb)
+        {
+            if (timeMs - pair.msbTime <= PAIR_TIMEOUT_MS)
+            {
+                clearPendingMsb(pair);
+                pairedValues.fetch_add(1, std::memory_order_relaxed);
+                emit(DecodedValue { channel, msbNumber, (pair.msb << 7) | lsb, true, timeMs });
+                return;
+            }
+
+            // Too late to pair - release the MSB the frame clock hasn't flushed yet
+            releasePendingMsb(pair, channel, msbNumber, emit);
+        }
+
+        if (pair.isLsbFirst && pair.sendsMsb)
+        {
+            // Hold until the MSB completes the pair, replacing an LSB still waiting
+            if (!pair.hasPendingLsb)
+                numPendingHalves.fetch_add(1, std::memory_order_relaxed);
+
+            pair.lsb = lsb;
+            pair.lsbTime = timeMs;
+            pair.hasPendingLsb = true;
+            return;
+        }
+
+        // No MSB to wait for - this is a controller in its own right
+        standaloneLsbs.fetch_add(1, std::memory_order_relaxed);
+        emit(DecodedValue { channel, msbNumber + 32, lsb << 7, false, timeMs });
+    }
+
+    template <typename EmitFunction>
+    void releasePendingMsb(PairState& pair, int channel, int msbNumber, EmitFunction&& emit)
+    {
+        // The LSB never came - treat it as zero
+        clearPendingMsb(pair);
+        unpairedValues.fetch_add(1, std::memory_order_relaxed);
+        emit(DecodedValue { channel, msbNumber, pair.msb << 7, true, pair.msbTime });
+    }
+
+    template <typename EmitFunction>
+    void releasePendingLsb(PairState& pair, int channel, int msbNumber, EmitFunction&& emit)
+    {
+        // The MSB never came - the LSB goes out as the 7-bit controller it was sent on
+        clearPendingLsb(pair);
+        standaloneLsbs.fetch_add(1, std::memory_order_relaxed);
+        emit(DecodedValue { channel, msbNumber + 32, pair.lsb << 7, false, pair.lsbTime });
+    }
+
+    void clearPendingMsb(PairState& pair) noexcept
+    {
+        pair.hasPendingMsb = false;
+        numPendingHalves.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void clearPendingLsb(PairState& pair) noexcept
+    {
+        pair.hasPendingLsb = false;
+        numPendingHalves.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    static constexpr int NUM_PAIRS = 16 * 32;
+
+    juce::SpinLock stateLock;
+    std::array<PairState, NUM_PAIRS> pairStates;
+    std::atomic<int> numPendingHalves { 0 };
+
+    std::atomic<uint64_t> pairedValues { 0 };
+    std::atomic<uint64_t> unpairedValues { 0 };
+    std::atomic<uint64_t> standaloneLsbs { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Midi14BitDecoder)
+};
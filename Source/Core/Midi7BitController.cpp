@@ -1,4 +1,6 @@
 #include "Midi7BitController.h"
+#include "CoreLog.h"
+#include "LatencyTracer.h"
 
 //==============================================================================
 Midi7BitController::Midi7BitController()
@@ -9,7 +11,9 @@ Midi7BitController::Midi7BitController()
     currentLearnTarget.ccNumber = -1;
     currentLearnTarget.channel = -1;
     
-    DBG("Midi7BitController: Created with extended target system");
+    rebuildDispatchTable();
+    
+    CORE_LOG_DEBUG("Midi7BitController", "Created with extended target system");
 }
 
 Midi7BitController::~Midi7BitController()
@@ -17,32 +21,34 @@ Midi7BitController::~Midi7BitController()
     // Stop timer before destruction
     stopTimer();
     
-    DBG("Midi7BitController: Destroyed");
+    CORE_LOG_DEBUG("Midi7BitController", "Destroyed");
 }
 
 //==============================================================================
 void Midi7BitController::processIncomingCC(int ccNumber, int ccValue, int channel)
 {
-    juce::String debugMsg = "Midi7BitController::processIncomingCC: CC=" + juce::String(ccNumber) + " Val=" + juce::String(ccValue) + " Ch=" + juce::String(channel) + " (learn mode: " + juce::String((int)learningMode) + " target type=" + juce::String((int)currentLearnTarget.targetType) + " slider=" + juce::String(currentLearnTarget.sliderIndex) + ")"; 
-    DBG(debugMsg);
+    CORE_LOG_TRACE("Midi7BitController", "processIncomingCC: CC=" << ccNumber << " Val=" << ccValue << " Ch=" << channel
+                   << " (learn mode: " << (int)learningMode << " target type=" << (int)currentLearnTarget.targetType
+                   << " slider=" << currentLearnTarget.sliderIndex << ")");
     
     // LEARN MODE: Process on ANY channel (hardware controllers use different channels)
     if (learningMode && currentLearnTarget.sliderIndex != -1)
     {
-        DBG("LEARN MODE: Processing CC " + juce::String(ccNumber) + " from channel " + juce::String(channel));
+        CORE_LOG_DEBUG("Midi7BitController", "Learn mode: processing CC " << ccNumber << " from channel " << channel);
         handleLearnMode(ccNumber, ccValue, channel);
         return; // Early return - learn mode takes priority
     }
     
     // Find target for this CC number and channel
-    MidiTargetInfo* target = findTargetForCC(ccNumber, channel);
+    const MidiTargetInfo* target = findTargetForCC(ccNumber, channel);
     if (!target)
     {
-        DBG("No target mapped to CC " + juce::String(ccNumber) + " Ch " + juce::String(channel));
+        CORE_LOG_TRACE("Midi7BitController", "No target mapped to CC " << ccNumber << " Ch " << channel);
         return;
     }
     
-    DBG("Found target: " + target->getDisplayName());
+    CORE_LOG_TRACE("Midi7BitController", "Found target: " << target->getDisplayName());
+    LatencyTracer::getInstance().markDispatch();
     
     // Process based on target type
     switch (target->targetType)
@@ -60,7 +66,7 @@ void Midi7BitController::processIncomingCC(int ccNumber, int ccValue, int channe
         case MidiTargetType::AutomationAttack:
         case MidiTargetType::AutomationReturn:
         case MidiTargetType::AutomationCurve:
-            processAutomationKnobTarget(*target, ccValue);
+            processAutomationKnobTarget(*target, ccValue / 127.0);
             break;
         case MidiTargetType::AutomationConfig:
             processAutomationConfigTarget(*target, ccValue);
@@ -68,6 +74,48 @@ void Midi7BitController::processIncomingCC(int ccNumber, int ccValue, int channe
     }
 }
 
+void Midi7BitController::processIncoming14BitCC(int ccNumber, int value14bit, int channel)
+{
+    CORE_LOG_TRACE("Midi7BitController", "processIncoming14BitCC: CC=" << ccNumber << " Val=" << value14bit << " Ch=" << channel);
+    
+    int msbValue = value14bit >> 7;
+    
+    // Learn the MSB controller, exactly as a 7-bit move would
+    if (learningMode && currentLearnTarget.sliderIndex != -1)
+    {
+        handleLearnMode(ccNumber, msbValue, channel);
+        return;
+    }
+    
+    const MidiTargetInfo* target = findTargetForCC(ccNumber, channel);
+    if (!target)
+        return;
+    
+    LatencyTracer::getInstance().markDispatch();
+    
+    switch (target->targetType)
+    {
+        case MidiTargetType::SliderValue:
+            processHighResolutionSliderTarget(*target, value14bit);
+            break;
+        case MidiTargetType::BankCycle:
+            processBankCycleTarget(msbValue);
+            break;
+        case MidiTargetType::AutomationGO:
+            processAutomationToggleTarget(*target, msbValue);
+            break;
+        case MidiTargetType::AutomationDelay:
+        case MidiTargetType::AutomationAttack:
+        case MidiTargetType::AutomationReturn:
+        case MidiTargetType::AutomationCurve:
+            processAutomationKnobTarget(*target, value14bit / 16383.0);
+            break;
+        case MidiTargetType::AutomationConfig:
+            processAutomationConfigTarget(*target, msbValue);
+            break;
+    }
+}
+
 //==============================================================================
 void Midi7BitController::startLearnMode()
 {
@@ -76,7 +124,7 @@ void Midi7BitController::startLearnMode()
     if (onLearnModeChanged)
         onLearnModeChanged();
         
-    DBG("Midi7BitController: Learn mode started");
+    CORE_LOG_DEBUG("Midi7BitController", "Learn mode started");
 }
 
 void Midi7BitController::stopLearnMode()
@@ -88,7 +136,7 @@ void Midi7BitController::stopLearnMode()
     if (onLearnModeChanged)
         onLearnModeChanged();
         
-    DBG("Midi7BitController: Learn mode stopped");
+    CORE_LOG_DEBUG("Midi7BitController", "Learn mode stopped");
 }
 
 void Midi7BitController::setLearnTarget(MidiTargetType targetType, int sliderIndex)
@@ -98,7 +146,7 @@ void Midi7BitController::setLearnTarget(MidiTargetType targetType, int sliderInd
     currentLearnTarget.ccNumber = -1;
     currentLearnTarget.channel = -1;
     
-    DBG("Midi7BitController: Learn target set to " + currentLearnTarget.getDisplayName());
+    CORE_LOG_DEBUG("Midi7BitController", "Learn target set to " << currentLearnTarget.getDisplayName());
 }
 
 void Midi7BitController::clearMapping(int sliderIndex)
@@ -112,11 +160,12 @@ void Midi7BitController::clearMapping(int sliderIndex)
                     return target.sliderIndex == sliderIndex;
                 }),
             targetMappings.end());
+        rebuildDispatchTable();
         
         if (onMappingCleared)
             onMappingCleared(sliderIndex);
             
-        DBG("Midi7BitController: Cleared all mappings for slider " + juce::String(sliderIndex));
+        CORE_LOG_DEBUG("Midi7BitController", "Cleared all mappings for slider " << sliderIndex);
     }
 }
 
@@ -129,14 +178,16 @@ void Midi7BitController::clearTargetMapping(MidiTargetType targetType, int slide
                 return target.targetType == targetType && target.sliderIndex == sliderIndex;
             }),
         targetMappings.end());
+    rebuildDispatchTable();
     
     MidiTargetInfo tempTarget{targetType, sliderIndex, -1, -1};
-    DBG("Midi7BitController: Cleared mapping for " + tempTarget.getDisplayName());
+    CORE_LOG_DEBUG("Midi7BitController", "Cleared mapping for " << tempTarget.getDisplayName());
 }
 
 void Midi7BitController::clearAllMappings()
 {
     targetMappings.clear();
+    rebuildDispatchTable();
     
     for (int i = 0; i < 16; ++i)
     {
@@ -144,7 +195,7 @@ void Midi7BitController::clearAllMappings()
             onMappingCleared(i);
     }
     
-    DBG("Midi7BitController: Cleared all mappings");
+    CORE_LOG_DEBUG("Midi7BitController", "Cleared all mappings");
 }
 
 bool Midi7BitController::isInLearnMode() const
@@ -172,6 +223,19 @@ std::vector<Midi7BitController::MappingInfo> Midi7BitController::getAllMappings(
     return mappings;
 }
 
+bool Midi7BitController::isSliderDrivenByCoarseInput(int sliderIndex) const
+{
+    if (!juce::isPositiveAndBelow(sliderIndex, (int)controlStates.size()))
+        return false;
+
+    const auto& controlState = controlStates[(size_t)sliderIndex];
+    if (!controlState.isActive || controlState.isHighResolutionInput)
+        return false;
+
+    return controlState.isMoving
+        || juce::Time::getMillisecondCounterHiRes() - controlState.lastUpdateTime < COARSE_INPUT_HOLD_MS;
+}
+
 //==============================================================================
 void Midi7BitController::timerCallback()
 {
@@ -181,13 +245,12 @@ void Midi7BitController::timerCallback()
 //==============================================================================
 void Midi7BitController::handleLearnMode(int ccNumber, int ccValue, int channel)
 {
-    juce::String debugMsg = "Midi7BitController::handleLearnMode called: CC=" + juce::String(ccNumber) + " Val=" + juce::String(ccValue) + " Ch=" + juce::String(channel) + " target=" + currentLearnTarget.getDisplayName();
-    DBG(debugMsg);
+    CORE_LOG_TRACE("Midi7BitController", "handleLearnMode: CC=" << ccNumber << " Val=" << ccValue << " Ch=" << channel
+                   << " target=" << currentLearnTarget.getDisplayName());
         
     if (currentLearnTarget.sliderIndex != -1 || currentLearnTarget.targetType == MidiTargetType::BankCycle)
     {
-        juce::String debugMsg = "Creating mapping: " + currentLearnTarget.getDisplayName() + " -> CC " + juce::String(ccNumber) + " Ch " + juce::String(channel);
-        DBG(debugMsg);
+        CORE_LOG_DEBUG("Midi7BitController", "Creating mapping: " << currentLearnTarget.getDisplayName() << " -> CC " << ccNumber << " Ch " << channel);
         
         // Create new target mapping
         MidiTargetInfo newMapping = currentLearnTarget;
@@ -204,6 +267,7 @@ void Midi7BitController::handleLearnMode(int ccNumber, int ccValue, int channel)
         
         // Add the new mapping
         targetMappings.push_back(newMapping);
+        rebuildDispatchTable();
         
         // Store values for callback (before resetting)
         MidiTargetType mappedTargetType = currentLearnTarget.targetType;
@@ -219,87 +283,120 @@ void Midi7BitController::handleLearnMode(int ccNumber, int ccValue, int channel)
                 onMappingLearned(mappedTargetType, mappedSliderIndex, ccNumber, channel);
                 
             MidiTargetInfo tempTarget{mappedTargetType, mappedSliderIndex, ccNumber, channel};
-            DBG("Midi7BitController: Called onMappingLearned for " + tempTarget.getDisplayName());
+            CORE_LOG_DEBUG("Midi7BitController", "Called onMappingLearned for " << tempTarget.getDisplayName());
         });
     }
     else
     {
-        DBG("handleLearnMode called but no valid target selected");
+        CORE_LOG_WARNING("Midi7BitController", "handleLearnMode called but no valid target selected");
     }
 }
 
-MidiTargetInfo* Midi7BitController::findTargetForCC(int ccNumber, int channel)
+const MidiTargetInfo* Midi7BitController::findTargetForCC(int ccNumber, int channel) const noexcept
 {
-    // Find target mapping for this CC and channel
-    for (auto& target : targetMappings)
+    if (!juce::isPositiveAndBelow(ccNumber, 128) || channel < 1 || channel > 16)
+        return nullptr;
+    
+    int targetIndex = dispatchTable.slots[(size_t)((channel - 1) * 128 + ccNumber)];
+    return targetIndex >= 0 ? &dispatchTable.targets[(size_t)targetIndex] : nullptr;
+}
+
+void Midi7BitController::rebuildDispatchTable()
+{
+    dispatchTable.slots.fill(-1);
+    dispatchTable.targets.clear();
+    dispatchTable.targets.reserve(targetMappings.size());
+    
+    for (const auto& target : targetMappings)
     {
-        if (target.ccNumber == ccNumber && target.channel == channel)
-        {
-            return &target;
-        }
+        if (!juce::isPositiveAndBelow(target.ccNumber, 128) || target.channel < 1 || target.channel > 16)
+            continue;
+        
+        auto& slot = dispatchTable.slots[(size_t)((target.channel - 1) * 128 + target.ccNumber)];
+        if (slot >= 0)
+            continue; // First mapping wins, as with the old linear search
+        
+        slot = (int16_t)dispatchTable.targets.size();
+        dispatchTable.targets.push_back(target);
     }
-    
-    DBG("No target mapping found for CC " + juce::String(ccNumber) + " Ch " + juce::String(channel));
-    return nullptr;
 }
 
 void Midi7BitController::processSliderTarget(const MidiTargetInfo& target, int ccValue)
 {
     int sliderIndex = target.sliderIndex;
     
-    // Move all UI-related processing to the message thread
-    juce::MessageManager::callAsync([this, sliderIndex, ccValue, target]() {
-        // Update MIDI tracking display
-        if (onMidiTooltipUpdate)
-            onMidiTooltipUpdate(sliderIndex, target.channel, target.ccNumber, ccValue);
-        
-        // Check if slider is locked
-        bool sliderIsLocked = false;
-        if (isSliderLocked)
-            sliderIsLocked = isSliderLocked(sliderIndex);
-            
-        if (sliderIsLocked)
-            return;
-        
-        auto& controlState = controlStates[sliderIndex];
-        controlState.lastCCValue = ccValue;
-        controlState.lastUpdateTime = juce::Time::getMillisecondCounterHiRes();
-        controlState.isActive = true;
-        
-        // Check if we're in the deadzone (58-68)
-        bool isInDeadzone = (ccValue >= DEADZONE_MIN && ccValue <= DEADZONE_MAX);
+    // Incoming MIDI is dispatched on the message thread, so UI updates happen inline
+    // Update MIDI tracking display
+    if (onMidiTooltipUpdate)
+        onMidiTooltipUpdate(sliderIndex, target.channel, target.ccNumber, ccValue);
+    
+    if (isSliderLocked(sliderIndex))
+        return;
+    
+    auto& controlState = controlStates[sliderIndex];
+    controlState.lastCCValue = ccValue;
+    controlState.lastUpdateTime = juce::Time::getMillisecondCounterHiRes();
+    controlState.isActive = true;
+    controlState.isHighResolutionInput = false;
+    
+    // Check if we're in the deadzone (58-68)
+    bool isInDeadzone = (ccValue >= DEADZONE_MIN && ccValue <= DEADZONE_MAX);
 
-        if (isInDeadzone)
-        {
-            // Stop continuous movement
-            controlState.isMoving = false;
-            controlState.movementSpeed = 0.0;
-        }
-        else
-        {
-            // Calculate movement speed based on distance from center
-            double distanceFromCenter = calculateDistanceFromCenter(ccValue);
-            controlState.movementSpeed = calculateExponentialSpeed(distanceFromCenter);
-            controlState.movementDirection = (ccValue > DEADZONE_MAX) ? 1.0 : -1.0;
-            controlState.isMoving = true;
-
-            // Start continuous movement timer if not already running
-            if (!isTimerRunning())
-                startTimer(TIMER_INTERVAL); // ~60fps
-        }
+    if (isInDeadzone)
+    {
+        // Stop continuous movement
+        controlState.isMoving = false;
+        controlState.movementSpeed = 0.0;
+    }
+    else
+    {
+        // Calculate movement speed based on distance from center
+        double distanceFromCenter = calculateDistanceFromCenter(ccValue);
+        controlState.movementSpeed = calculateExponentialSpeed(distanceFromCenter);
+        controlState.movementDirection = (ccValue > DEADZONE_MAX) ? 1.0 : -1.0;
+        controlState.isMoving = true;
 
-        // Send initial value update to slider with deadzone info
-        if (onSliderValueChanged)
-        {
-            // Convert 7-bit CC value to 14-bit range for slider
-            double convertedValue = (double(ccValue) / 127.0) * 16383.0;
-            onSliderValueChanged(sliderIndex, convertedValue, isInDeadzone);
-        }
-        
-        // Trigger activity indicator
-        if (onSliderActivityTrigger)
-            onSliderActivityTrigger(sliderIndex);
-    });
+        // Start continuous movement timer if not already running
+        if (!isTimerRunning())
+            startTimer(TIMER_INTERVAL); // ~60fps
+    }
+
+    // Send initial value update to slider with deadzone info
+    if (onSliderValueChanged)
+    {
+        // Convert 7-bit CC value to 14-bit range for slider
+        double convertedValue = (double(ccValue) / 127.0) * 16383.0;
+        onSliderValueChanged(sliderIndex, convertedValue, isInDeadzone);
+    }
+    
+    // Trigger activity indicator
+    if (onSliderActivityTrigger)
+        onSliderActivityTrigger(sliderIndex);
+}
+
+void Midi7BitController::processHighResolutionSliderTarget(const MidiTargetInfo& target, int value14bit)
+{
+    int sliderIndex = target.sliderIndex;
+    
+    if (onMidiTooltipUpdate)
+        onMidiTooltipUpdate(sliderIndex, target.channel, target.ccNumber, value14bit >> 7);
+    
+    if (isSliderLocked(sliderIndex))
+        return;
+    
+    // A 14-bit fader is absolute - cancel any continuous movement left by 7-bit input
+    auto& controlState = controlStates[sliderIndex];
+    controlState.lastUpdateTime = juce::Time::getMillisecondCounterHiRes();
+    controlState.isActive = true;
+    controlState.isHighResolutionInput = true;
+    controlState.isMoving = false;
+    controlState.movementSpeed = 0.0;
+    
+    if (onSliderValueChanged)
+        onSliderValueChanged(sliderIndex, (double)juce::jlimit(0, 16383, value14bit), false);
+    
+    if (onSliderActivityTrigger)
+        onSliderActivityTrigger(sliderIndex);
 }
 
 void Midi7BitController::processBankCycleTarget(int ccValue)
@@ -307,13 +404,10 @@ void Midi7BitController::processBankCycleTarget(int ccValue)
     // Trigger on CC value > threshold (like button press)
     if (ccValue >= 64)
     {
-        DBG("Bank cycle triggered with CC value " + juce::String(ccValue));
+        CORE_LOG_DEBUG("Midi7BitController", "Bank cycle triggered with CC value " << ccValue);
         
-        // Move to message thread for UI updates
-        juce::MessageManager::callAsync([this]() {
-            if (onBankCycleRequested)
-                onBankCycleRequested();
-        });
+        if (onBankCycleRequested)
+            onBankCycleRequested();
     }
 }
 
@@ -323,31 +417,24 @@ void Midi7BitController::processAutomationToggleTarget(const MidiTargetInfo& tar
     // This will start automation if stopped, or stop if already running
     int sliderIndex = target.sliderIndex;
     
-    juce::String debugMsg = "Automation GO click for slider " + juce::String(sliderIndex) + " (CC value: " + juce::String(ccValue) + ")";
-    DBG(debugMsg);
+    CORE_LOG_DEBUG("Midi7BitController", "Automation GO click for slider " << sliderIndex << " (CC value: " << ccValue << ")");
     
-    // Move to message thread for UI updates (pass true for shouldStart, but the callback will handle toggle logic)
-    juce::MessageManager::callAsync([this, sliderIndex]() {
-        if (onAutomationToggle)
-            onAutomationToggle(sliderIndex, true); // The callback handles the actual toggle logic
-    });
+    // Pass true for shouldStart, but the callback will handle toggle logic
+    if (onAutomationToggle)
+        onAutomationToggle(sliderIndex, true); // The callback handles the actual toggle logic
 }
 
-void Midi7BitController::processAutomationKnobTarget(const MidiTargetInfo& target, int ccValue)
+void Midi7BitController::processAutomationKnobTarget(const MidiTargetInfo& target, double normalizedValue)
 {
-    // Convert 0-127 MIDI to knob's native range
-    double normalizedValue = ccValue / 127.0;
+    // Convert the normalized 0-1 controller value to knob's native range
     double knobValue = convertToKnobRange(target.targetType, normalizedValue);
     int sliderIndex = target.sliderIndex;
     
-    juce::String debugMsg = "Automation knob " + target.getDisplayName() + ": " + juce::String(knobValue) + " (CC value: " + juce::String(ccValue) + ")";
-    DBG(debugMsg);
+    CORE_LOG_TRACE("Midi7BitController", "Automation knob " << target.getDisplayName() << ": " << knobValue << " (normalized: " << normalizedValue << ")");
     
-    // Move to message thread for UI updates (direct control, no deadzone)
-    juce::MessageManager::callAsync([this, sliderIndex, targetType = target.targetType, knobValue]() {
-        if (onAutomationKnobChanged)
-            onAutomationKnobChanged(sliderIndex, targetType, knobValue);
-    });
+    // Direct control, no deadzone
+    if (onAutomationKnobChanged)
+        onAutomationKnobChanged(sliderIndex, target.targetType, knobValue);
 }
 
 double Midi7BitController::convertToKnobRange(MidiTargetType knobType, double normalizedValue) const
@@ -395,18 +482,16 @@ void Midi7BitController::processAutomationConfigTarget(const MidiTargetInfo& tar
     
     if (target.configId.isEmpty())
     {
-        DBG("AutomationConfig target has empty config ID");
+        CORE_LOG_WARNING("Midi7BitController", "AutomationConfig target has empty config ID");
         return;
     }
     
-    juce::String debugMsg = "Automation config triggered: " + target.configId + " (CC value: " + juce::String(ccValue) + ")";
-    DBG(debugMsg);
+    CORE_LOG_DEBUG("Midi7BitController", "Automation config triggered: " << target.configId << " (CC value: " << ccValue << ")");
     
-    // Move to message thread for config processing
-    juce::MessageManager::callAsync([this, configId = target.configId, ccValue]() {
-        if (onAutomationConfigTriggered)
-            onAutomationConfigTriggered(configId, ccValue);
-    });
+    // Copy the ID - the callback may change the mappings this target lives in
+    auto configId = target.configId;
+    if (onAutomationConfigTriggered)
+        onAutomationConfigTriggered(configId, ccValue);
 }
 
 void Midi7BitController::updateContinuousMovement()
@@ -428,12 +513,7 @@ void Midi7BitController::updateContinuousMovement()
                 continue;
             }
             
-            // Check if slider is locked
-            bool sliderIsLocked = false;
-            if (isSliderLocked)
-                sliderIsLocked = isSliderLocked(i);
-                
-            if (sliderIsLocked)
+            if (isSliderLocked(i))
                 continue;
             
             anySliderMoving = true;
@@ -442,11 +522,8 @@ void Midi7BitController::updateContinuousMovement()
             double deltaTime = 1.0 / 60.0; // 60fps
             double movementDelta = state.movementSpeed * deltaTime * state.movementDirection;
             
-            // Get current slider value and apply movement
-            double currentValue = 0.0;
-            if (getSliderValue)
-                currentValue = getSliderValue(i);
-                
+            // Apply movement to the slider's current value
+            double currentValue = sliderStateStore != nullptr ? (double)sliderStateStore->getValue(i) : 0.0;
             double newValue = juce::jlimit(0.0, 16383.0, currentValue + movementDelta);
             
             // Update slider value through callback (continuous movement is outside deadzone)
@@ -455,11 +532,7 @@ void Midi7BitController::updateContinuousMovement()
         }
     }
     
-    // Stop timer if no sliders are moving (thread-safe)
+    // Stop timer if no sliders are moving (timer callbacks run on the message thread)
     if (!anySliderMoving)
-    {
-        juce::MessageManager::callAsync([this]() {
-            stopTimer();
-        });
-    }
+        stopTimer();
 }
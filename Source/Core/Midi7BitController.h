@@ -4,6 +4,7 @@
 #include <array>
 #include <vector>
 #include <unordered_map>
+#include "SliderStateStore.h"
 
 //==============================================================================
 /**
@@ -81,6 +82,7 @@ struct MidiTargetInfo
  * Midi7BitController handles 7-bit to 14-bit MIDI control conversion, learn mode, and continuous movement
  * Extracted from DebugMidiController to provide clean separation of concerns
  * Extended to support multiple target types beyond just slider values
+ * Message thread only - MidiManager delivers incoming MIDI there
  */
 class Midi7BitController : public juce::Timer
 {
@@ -88,9 +90,14 @@ public:
     Midi7BitController();
     ~Midi7BitController();
     
-    // MIDI processing
+    // MIDI processing - call on the message thread (MidiManager dispatches incoming
+    // events there in per-frame batches), so target callbacks run inline
     void processIncomingCC(int ccNumber, int ccValue, int channel);
     
+    // Decoded 14-bit MSB/LSB pair: slider targets jump to the absolute value, knobs use the
+    // full resolution and other targets behave as their 7-bit MSB
+    void processIncoming14BitCC(int ccNumber, int value14bit, int channel);
+    
     // Learn mode management
     void startLearnMode();
     void stopLearnMode();
@@ -116,6 +123,13 @@ public:
     };
     std::vector<MappingInfo> getAllMappings() const;
     
+    // Slider values and lock flags are read from the shared store (set before input arrives)
+    void setSliderStateStore(const SliderStateStore* store) { sliderStateStore = store; }
+    
+    // True while a slider is being moved by 7-bit input (directly or by deadzone movement),
+    // whose 129-unit steps are worth smoothing on output. 14-bit input clears it at once.
+    bool isSliderDrivenByCoarseInput(int sliderIndex) const;
+    
     // Callbacks for parent components
     std::function<void(int sliderIndex, double newValue, bool isInDeadzone)> onSliderValueChanged;
     std::function<void(MidiTargetType targetType, int sliderIndex, int ccNumber, int channel)> onMappingLearned;
@@ -123,8 +137,6 @@ public:
     std::function<void()> onLearnModeChanged;
     std::function<void(int sliderIndex, int channel, int ccNumber, int ccValue)> onMidiTooltipUpdate;
     std::function<void(int sliderIndex)> onSliderActivityTrigger;
-    std::function<bool(int sliderIndex)> isSliderLocked;
-    std::function<double(int sliderIndex)> getSliderValue;
     
     // New callbacks for extended target types
     std::function<void()> onBankCycleRequested;
@@ -138,11 +150,13 @@ private:
     
     // Internal processing methods
     void handleLearnMode(int ccNumber, int ccValue, int channel);
-    MidiTargetInfo* findTargetForCC(int ccNumber, int channel);
+    const MidiTargetInfo* findTargetForCC(int ccNumber, int channel) const noexcept;
+    void rebuildDispatchTable();
     void processSliderTarget(const MidiTargetInfo& target, int ccValue);
+    void processHighResolutionSliderTarget(const MidiTargetInfo& target, int value14bit);
     void processBankCycleTarget(int ccValue);
     void processAutomationToggleTarget(const MidiTargetInfo& target, int ccValue);
-    void processAutomationKnobTarget(const MidiTargetInfo& target, int ccValue);
+    void processAutomationKnobTarget(const MidiTargetInfo& target, double normalizedValue);
     void processAutomationConfigTarget(const MidiTargetInfo& target, int ccValue);
     double convertToKnobRange(MidiTargetType knobType, double normalizedValue) const;
     double calculateDistanceFromCenter(int ccValue) const;
@@ -157,16 +171,31 @@ private:
         double movementDirection = 0.0;
         bool isMoving = false;
         bool isActive = false;
+        bool isHighResolutionInput = false;
     };
     
+    bool isSliderLocked(int sliderIndex) const { return sliderStateStore != nullptr && sliderStateStore->isLocked(sliderIndex); }
+    
     // Member variables
+    const SliderStateStore* sliderStateStore = nullptr;
     std::array<Midi7BitControlState, 16> controlStates;
     std::vector<MidiTargetInfo> targetMappings; // New comprehensive mapping system
+    
+    // Compiled lookup for incoming CCs: one slot per (channel, CC) holding an index into a
+    // compact copy of targetMappings, or -1. Message thread only - it is rebuilt whenever
+    // the mappings change and read by processIncomingCC, which runs there too.
+    struct DispatchTable
+    {
+        std::vector<MidiTargetInfo> targets;
+        std::array<int16_t, 16 * 128> slots;
+    };
+    DispatchTable dispatchTable;
     bool learningMode = false;
     MidiTargetInfo currentLearnTarget; // Current target being learned
     
     // Constants
     static constexpr double MOVEMENT_TIMEOUT = 100.0; // milliseconds
+    static constexpr double COARSE_INPUT_HOLD_MS = 250.0;
     static constexpr int DEADZONE_MIN = 58;
     static constexpr int DEADZONE_MAX = 68;
     static constexpr int DEADZONE_CENTER = 63;
@@ -0,0 +1,147 @@
+#include "MidiBandwidthBudget.h"
+#include "CoreLog.h"
+
+//==============================================================================
+MidiBandwidthBudget::MidiBandwidthBudget()
+{
+    CORE_LOG_DEBUG("MidiBandwidthBudget", "Created");
+}
+
+//==============================================================================
+void MidiBandwidthBudget::setBaudRate(int baud)
+{
+    baudRate = juce::jmax(0, baud);
+    CORE_LOG_DEBUG("MidiBandwidthBudget", "Baud rate set to " << baudRate.load() << (baud > 0 ? "" : " (unlimited)"));
+}
+
+double MidiBandwidthBudget::getBytesPerMs() const
+{
+    // 10 bits on the wire per byte (start + 8 data + stop)
+    int baud = baudRate.load();
+    return (baud > 0 ? baud : DIN_BAUD_RATE) / 10.0 / 1000.0;
+}
+
+double MidiBandwidthBudget::getBucketCapacity() const
+{
+    // Always room for at least one full 14-bit pair
+    return juce::jmax(6.0, getBytesPerMs() * BUCKET_DURATION_MS);
+}
+
+//==============================================================================
+void MidiBandwidthBudget::refill(double nowMs)
+{
+    if (lastRefillTime <= 0.0)
+    {
+        lastRefillTime = nowMs;
+        windowStartTime = nowMs;
+        availableBytes = getBucketCapacity();
+    }
+    
+    double elapsed = nowMs - lastRefillTime;
+    lastRefillTime = nowMs;
+    
+    // Bytes sent by other paths share the same wire - scheduled slots count once they have gone out
+    int external = externalBytes.exchange(0, std::memory_order_relaxed);
+    
+    auto currentSlot = (int64_t)std::floor(nowMs / SCHEDULE_SLOT_MS);
+    if (lastChargedSlot < 0 || currentSlot - lastChargedSlot > (int64_t)scheduledSlots.size())
+        lastChargedSlot = currentSlot - 1;
+    
+    while (lastChargedSlot < currentSlot - 1)
+        external += getScheduledBytes(++lastChargedSlot);
+    
+    if (external > 0)
+    {
+        windowBytes += external;
+        totalBytes.fetch_add((uint64_t)external, std::memory_order_relaxed);
+    }
+    
+    availableBytes = juce::jmin(getBucketCapacity(), availableBytes + elapsed * getBytesPerMs() - external);
+    
+    // Publish utilization relative to the link (or to DIN speed when unlimited)
+    double windowLength = nowMs - windowStartTime;
+    if (windowLength >= UTILIZATION_WINDOW_MS)
+    {
+        double rate = windowBytes * 1000.0 / windowLength;
+        bytesPerSecond.store(rate, std::memory_order_relaxed);
+        utilization.store((float)(rate / (getBytesPerMs() * 1000.0)), std::memory_order_relaxed);
+        windowStartTime = nowMs;
+        windowBytes = 0.0;
+    }
+}
+
+bool MidiBandwidthBudget::canSend(int bytes, MidiOutputPriority priority) const
+{
+    if (!isLimited())
+        return true;
+    
+    double headroom = 0.0;
+    if (priority == MidiOutputPriority::Automation)
+        headroom = getBucketCapacity() * AUTOMATION_HEADROOM;
+    else if (priority == MidiOutputPriority::Bulk)
+        headroom = getBucketCapacity() * BULK_HEADROOM;
+    
+    return availableBytes - bytes >= headroom;
+}
+
+//==============================================================================
+int MidiBandwidthBudget::getScheduledBytes(int64_t slotIndex) const
+{
+    const auto& slot = scheduledSlots[(size_t)(slotIndex % (int64_t)scheduledSlots.size())];
+    return slot.index.load(std::memory_order_acquire) == slotIndex ? slot.bytes.load(std::memory_order_relaxed) : 0;
+}
+
+double MidiBandwidthBudget::reserveScheduled(double timeMs, int bytes, bool mustSend)
+{
+    if (!isLimited())
+    {
+        chargeExternal(bytes);
+        return timeMs;
+    }
+    
+    // Scheduled output is automation traffic - it leaves the same headroom for manual moves
+    double slotCapacity = getBytesPerMs() * SCHEDULE_SLOT_MS * (1.0 - AUTOMATION_HEADROOM);
+    auto slotIndex = (int64_t)std::floor(timeMs / SCHEDULE_SLOT_MS);
+    auto lastSlot = slotIndex + (int64_t)scheduledSlots.size() - 1;
+    
+    for (; slotIndex <= lastSlot; ++slotIndex)
+    {
+        auto& slot = scheduledSlots[(size_t)(slotIndex % (int64_t)scheduledSlots.size())];
+        if (slot.index.load(std::memory_order_relaxed) != slotIndex)
+        {
+            slot.bytes.store(0, std::memory_order_relaxed);
+            slot.index.store(slotIndex, std::memory_order_release);
+        }
+        
+        // An empty slot always takes one message, however slow the link
+        int used = slot.bytes.load(std::memory_order_relaxed);
+        if (used == 0 || used + bytes <= slotCapacity)
+        {
+            slot.bytes.fetch_add(bytes, std::memory_order_relaxed);
+            return juce::jmax(timeMs, (double)slotIndex * SCHEDULE_SLOT_MS);
+        }
+        
+        if (!mustSend)
+            return -1.0;
+    }
+    
+    return -1.0;
+}
+
+void MidiBandwidthBudget::clearScheduled(double nowMs)
+{
+    // The current slot may already be on the wire - only release the ones ahead of it
+    auto currentSlot = (int64_t)std::floor(nowMs / SCHEDULE_SLOT_MS);
+    for (auto& slot : scheduledSlots)
+    {
+        if (slot.index.load(std::memory_order_relaxed) > currentSlot)
+            slot.index.store(-1, std::memory_order_release);
+    }
+}
+
+void MidiBandwidthBudget::consume(int bytes)
+{
+    availableBytes -= bytes;
+    windowBytes += bytes;
+    totalBytes.fetch_add((uint64_t)bytes, std::memory_order_relaxed);
+}
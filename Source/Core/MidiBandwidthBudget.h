@@ -0,0 +1,97 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "MidiOutputQueue.h"
+
+//==============================================================================
+/**
+ * MidiBandwidthBudget models the byte budget of one MIDI output port as a token bucket
+ * refilled at baud/10 bytes per second (8 data bits + start/stop bits). The output thread
+ * asks it before sending, so a 31250-baud DIN link is never overrun. Byte counts are
+ * MidiWireEncoder's estimates - close for a raw serial link, a model for anything else.
+ * Lower priority classes must leave headroom in the bucket so manual moves are always
+ * served first.
+ * A baud rate of 0 means unlimited (USB/virtual ports) - usage is still measured.
+ *
+ * Pre-scheduled blocks leave the port ahead of time, so they reserve wire time instead:
+ * each SCHEDULE_SLOT_MS slot accepts scheduled bytes up to the automation share of the
+ * link, and refill() charges a slot's reservation once the slot has gone out.
+ */
+class MidiBandwidthBudget
+{
+public:
+    MidiBandwidthBudget();
+    ~MidiBandwidthBudget() = default;
+    
+    // Configuration (any thread)
+    void setBaudRate(int baud);
+    int getBaudRate() const { return baudRate.load(); }
+    bool isLimited() const { return baudRate.load() > 0; }
+    
+    // Budget accounting (output thread only)
+    void refill(double nowMs);
+    bool canSend(int bytes, MidiOutputPriority priority) const;
+    void consume(int bytes);
+    void noteDeferred() { deferredEvents.fetch_add(1, std::memory_order_relaxed); }
+    
+    // Bytes sent by other paths (e.g. pre-scheduled blocks) - any thread
+    void chargeExternal(int bytes) { externalBytes.fetch_add(bytes, std::memory_order_relaxed); }
+    
+    // Pre-scheduled output (message thread only). Returns the time the message may go out,
+    // or -1 when its slot is full - a message that must be sent moves to the next free slot.
+    double reserveScheduled(double timeMs, int bytes, bool mustSend);
+    void clearScheduled(double nowMs);
+    
+    // Live metrics (any thread)
+    float getUtilization() const { return utilization.load(std::memory_order_relaxed); }
+    double getBytesPerSecond() const { return bytesPerSecond.load(std::memory_order_relaxed); }
+    uint64_t getTotalBytesSent() const { return totalBytes.load(std::memory_order_relaxed); }
+    uint64_t getDeferredEventCount() const { return deferredEvents.load(std::memory_order_relaxed); }
+    
+    static constexpr int DIN_BAUD_RATE = 31250;
+    
+private:
+    double getBytesPerMs() const;
+    double getBucketCapacity() const;
+    
+    // Configuration
+    std::atomic<int> baudRate { 0 };
+    
+    // Token bucket state (output thread)
+    double availableBytes = 0.0;
+    double lastRefillTime = 0.0;
+    int64_t lastChargedSlot = -1;
+    
+    // Scheduled wire time, tagged with the absolute slot index it belongs to
+    struct ScheduledSlot
+    {
+        std::atomic<int64_t> index { -1 };
+        std::atomic<int> bytes { 0 };
+    };
+    
+    int getScheduledBytes(int64_t slotIndex) const;
+    
+    std::array<ScheduledSlot, 64> scheduledSlots;
+    
+    // Utilization measurement window (output thread)
+    double windowStartTime = 0.0;
+    double windowBytes = 0.0;
+    
+    // Published metrics
+    std::atomic<int> externalBytes { 0 };
+    std::atomic<float> utilization { 0.0f };
+    std::atomic<double> bytesPerSecond { 0.0 };
+    std::atomic<uint64_t> totalBytes { 0 };
+    std::atomic<uint64_t> deferredEvents { 0 };
+    
+    // Constants
+    static constexpr double BUCKET_DURATION_MS = 20.0;      // Burst allowance
+    static constexpr double UTILIZATION_WINDOW_MS = 250.0;
+    static constexpr double AUTOMATION_HEADROOM = 0.1;      // Fraction of bucket kept for manual moves
+    static constexpr double BULK_HEADROOM = 0.3;            // Fraction of bucket kept for manual + automation
+    static constexpr double SCHEDULE_SLOT_MS = 5.0;         // Granularity of scheduled reservations
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiBandwidthBudget)
+};
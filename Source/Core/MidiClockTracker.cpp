@@ -0,0 +1,239 @@
+#include "MidiClockTracker.h"
+#include "CoreLog.h"
+#include <cmath>
+
+//==============================================================================
+MidiClockTracker::MidiClockTracker()
+{
+    CORE_LOG_DEBUG("MidiClockTracker", "Created");
+}
+
+//==============================================================================
+void MidiClockTracker::handleClock(double timeMs)
+{
+    // A long gap (clock stopped, cable pulled, tempo jump) makes the old window meaningless
+    double expectedInterval = fittedMsPerTick > 0.0 ? fittedMsPerTick : CLOCK_TIMEOUT_MS / 4.0;
+    if (windowCount > 0 && (timeMs - lastTickTime > expectedInterval * 3.0 || timeMs - lastTickTime > CLOCK_TIMEOUT_MS))
+    {
+        windowCount = 0;
+        numOutliers = 0;
+    }
+
+    double fittedTime = timeMs;
+    lastTickTime = timeMs;
+
+    if (windowCount >= MIN_TICKS_FOR_REGRESSION)
+    {
+        double predictedTime = fittedLastTickTime + fittedMsPerTick;
+        double deviation = timeMs - predictedTime;
+
+        if (std::abs(deviation) > fittedMsPerTick * TEMPO_CHANGE_TOLERANCE)
+        {
+            int side = deviation > 0.0 ? 1 : -1;
+            if (numOutliers > 0 && side != outlierSide)
+                numOutliers = 0;
+            outlierSide = side;
+
+            if (numOutliers + 1 < TEMPO_CHANGE_TICKS)
+            {
+                // A lone tick far off the line is jitter - it goes into the window at its
+                // predicted time, so it neither bends the fit nor shifts the tick indices
+                outlierTimes[(size_t)numOutliers++] = timeMs;
+                fittedTime = predictedTime;
+            }
+            else
+            {
+                // Several ticks in a row on the same side: a tempo change. Refit from the
+                // last tick before the run, with the run's real arrival times.
+                windowStart = (windowStart + windowCount - numOutliers - 1) % WINDOW_SIZE;
+                windowCount = 1;
+                for (int i = 0; i < numOutliers; ++i)
+                    tickTimes[(size_t)((windowStart + windowCount++) % WINDOW_SIZE)] = outlierTimes[(size_t)i];
+                numOutliers = 0;
+            }
+        }
+        else
+        {
+            numOutliers = 0;
+        }
+    }
+
+    // Append to the regression window, dropping the oldest tick when full
+    if (windowCount == WINDOW_SIZE)
+    {
+        windowStart = (windowStart + 1) % WINDOW_SIZE;
+        --windowCount;
+    }
+    tickTimes[(size_t)((windowStart + windowCount) % WINDOW_SIZE)] = fittedTime;
+    ++windowCount;
+
+    // Song position only advances while the transport runs (DAWs keep clocking when stopped)
+    if (running)
+        lastTick = nextTick++;
+
+    estimate(fittedTime);
+    publish();
+}
+
+void MidiClockTracker::handleStart(double timeMs)
+{
+    // The first clock after Start is the downbeat at position 0
+    running = true;
+    nextTick = 0;
+    lastTick = 0;
+    fittedLastTickTime = timeMs;
+    ++transportChanges;
+    publish();
+    CORE_LOG_DEBUG("MidiClockTracker", "Start");
+}
+
+void MidiClockTracker::handleContinue(double timeMs)
+{
+    running = true;
+    lastTick = nextTick;
+    fittedLastTickTime = timeMs;
+    ++transportChanges;
+    publish();
+    CORE_LOG_DEBUG("MidiClockTracker", "Continue from tick " << (juce::int64)nextTick);
+}
+
+void MidiClockTracker::handleStop(double timeMs)
+{
+    juce::ignoreUnused(timeMs);
+    running = false;
+    ++transportChanges;
+    publish();
+    CORE_LOG_DEBUG("MidiClockTracker", "Stop at tick " << (juce::int64)nextTick);
+}
+
+void MidiClockTracker::handleSongPosition(int midiBeats, double timeMs)
+{
+    juce::ignoreUnused(timeMs);
+    nextTick = (int64_t)juce::jmax(0, midiBeats) * TICKS_PER_MIDI_BEAT;
+    lastTick = nextTick;
+    ++transportChanges;
+    publish();
+    CORE_LOG_DEBUG("MidiClockTracker", "Song position " << midiBeats << " (tick " << (juce::int64)nextTick << ")");
+}
+
+//==============================================================================
+void MidiClockTracker::estimate(double timeMs)
+{
+    int n = windowCount;
+
+    if (n < 2)
+    {
+        fittedLastTickTime = timeMs;
+        return;
+    }
+
+    double firstTime = tickTimes[(size_t)windowStart];
+
+    if (n < MIN_TICKS_FOR_REGRESSION)
+    {
+        // Too few points to fit - use the mean interval until the window fills
+        fittedMsPerTick = (timeMs - firstTime) / (n - 1);
+        fittedLastTickTime = timeMs;
+        residualJitter = 0.0;
+        return;
+    }
+
+    // Least-squares fit of time = intercept + slope * tickIndex, with times taken relative
+    // to the first tick in the window to keep the sums well conditioned
+    double indexMean = (n - 1) * 0.5;
+    double timeMean = 0.0;
+    for (int i = 0; i < n; ++i)
+        timeMean += tickTimes[(size_t)((windowStart + i) % WINDOW_SIZE)] - firstTime;
+    timeMean /= n;
+
+    double covariance = 0.0;
+    double variance = 0.0;
+    for (int i = 0; i < n; ++i)
+    {
+        double di = i - indexMean;
+        double dt = tickTimes[(size_t)((windowStart + i) % WINDOW_SIZE)] - firstTime - timeMean;
+        covariance += di * dt;
+        variance += di * di;
+    }
+
+    double slope = covariance / variance;
+    if (slope <= 0.0)
+        return;
+
+    double intercept = timeMean - slope * indexMean;
+
+    double squaredError = 0.0;
+    for (int i = 0; i < n; ++i)
+    {
+        double residual = tickTimes[(size_t)((windowStart + i) % WINDOW_SIZE)] - firstTime - (intercept + slope * i);
+        squaredError += residual * residual;
+    }
+
+    fittedMsPerTick = slope;
+    fittedLastTickTime = firstTime + intercept + slope * (n - 1);
+    residualJitter = std::sqrt(squaredError / n);
+}
+
+void MidiClockTracker::publish()
+{
+    // While stopped the anchor is the position playback will start from
+    double anchorTick = running ? (double)lastTick : (double)nextTick;
+
+    sequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    publishedRunning.store(running, std::memory_order_relaxed);
+    publishedMsPerTick.store(fittedMsPerTick, std::memory_order_relaxed);
+    publishedAnchorTime.store(fittedLastTickTime, std::memory_order_relaxed);
+    publishedAnchorTick.store(anchorTick, std::memory_order_relaxed);
+    publishedLastTickTime.store(lastTickTime, std::memory_order_relaxed);
+    publishedJitter.store(residualJitter, std::memory_order_relaxed);
+    publishedTransportVersion.store(transportChanges, std::memory_order_relaxed);
+    sequence.fetch_add(1, std::memory_order_release);
+
+    updateCount.fetch_add(1, std::memory_order_release);
+}
+
+//==============================================================================
+MidiClockTracker::Snapshot MidiClockTracker::getSnapshot(double nowMs) const
+{
+    Snapshot snapshot;
+
+    for (;;)
+    {
+        uint32_t before = sequence.load(std::memory_order_acquire);
+        if ((before & 1) != 0)
+            continue;   // Writer mid-update - it only stores a handful of values
+
+        snapshot.isRunning = publishedRunning.load(std::memory_order_relaxed);
+        snapshot.msPerTick = publishedMsPerTick.load(std::memory_order_relaxed);
+        snapshot.anchorTimeMs = publishedAnchorTime.load(std::memory_order_relaxed);
+        snapshot.anchorTick = publishedAnchorTick.load(std::memory_order_relaxed);
+        snapshot.lastTickTimeMs = publishedLastTickTime.load(std::memory_order_relaxed);
+        snapshot.jitterMs = publishedJitter.load(std::memory_order_relaxed);
+        snapshot.transportVersion = publishedTransportVersion.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before)
+            break;
+    }
+
+    snapshot.isReceiving = snapshot.lastTickTimeMs > 0.0 && nowMs - snapshot.lastTickTimeMs < CLOCK_TIMEOUT_MS;
+    snapshot.bpm = snapshot.msPerTick > 0.0 ? 60000.0 / (snapshot.msPerTick * TICKS_PER_BEAT) : 0.0;
+    return snapshot;
+}
+
+void MidiClockTracker::reset()
+{
+    windowStart = 0;
+    windowCount = 0;
+    numOutliers = 0;
+    running = false;
+    nextTick = 0;
+    lastTick = 0;
+    fittedMsPerTick = 0.0;
+    fittedLastTickTime = 0.0;
+    residualJitter = 0.0;
+    lastTickTime = 0.0;
+    ++transportChanges;
+    publish();
+}
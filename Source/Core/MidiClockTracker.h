@@ -0,0 +1,103 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+/**
+ * MidiClockTracker follows an external MIDI clock (0xF8, 24 ticks per quarter note) together
+ * with start/stop/continue and song position pointer. It is fed on the MIDI callback thread
+ * with the messages' own timestamps and estimates the tick period by least-squares
+ * regression over the most recent ticks, so per-message jitter averages out of both tempo
+ * and phase instead of being passed on like a last-interval measurement would. A tick far
+ * off the fitted line only restarts the fit when the next ones land on the same side too;
+ * a lone one is taken at its predicted time.
+ *
+ * The estimate is published as a snapshot behind a sequence counter, so the message thread
+ * (TempoManager) and the automation clock can read a consistent tempo/phase pair lock-free.
+ */
+class MidiClockTracker
+{
+public:
+    struct Snapshot
+    {
+        bool isReceiving = false;       // Clock ticks are arriving (set by the reader's timeout check)
+        bool isRunning = false;         // Transport started/continued and not stopped
+        double bpm = 0.0;               // 0 until enough ticks have been seen
+        double msPerTick = 0.0;
+        double anchorTimeMs = 0.0;      // Fitted time of the latest tick (getMillisecondCounterHiRes clock)
+        double anchorTick = 0.0;        // Song position of that tick, in clock ticks
+        double lastTickTimeMs = 0.0;    // Raw arrival time of the latest tick
+        double jitterMs = 0.0;          // RMS deviation of the ticks from the fitted line
+        uint32_t transportVersion = 0;  // Bumped on start/stop/continue/song position
+
+        // Position in quarter notes at the given time, extrapolated from the fitted anchor
+        double getBeatPositionAt(double timeMs) const noexcept
+        {
+            if (!isRunning || msPerTick <= 0.0)
+                return anchorTick / TICKS_PER_BEAT;
+            return (anchorTick + (timeMs - anchorTimeMs) / msPerTick) / TICKS_PER_BEAT;
+        }
+    };
+
+    MidiClockTracker();
+    ~MidiClockTracker() = default;
+
+    // MIDI thread
+    void handleClock(double timeMs);
+    void handleStart(double timeMs);
+    void handleContinue(double timeMs);
+    void handleStop(double timeMs);
+    void handleSongPosition(int midiBeats, double timeMs);   // SPP value: sixteenth notes
+
+    // Any thread
+    Snapshot getSnapshot(double nowMs) const;
+    uint32_t getUpdateCount() const { return updateCount.load(std::memory_order_acquire); }
+    void reset();   // On the feeding MIDI thread, or while no MIDI input is open
+
+    static constexpr double TICKS_PER_BEAT = 24.0;
+    static constexpr int TICKS_PER_MIDI_BEAT = 6;          // One SPP unit (sixteenth note)
+    static constexpr double CLOCK_TIMEOUT_MS = 500.0;      // No tick for this long = clock lost
+
+private:
+    void estimate(double timeMs);
+    void publish();
+
+    // Regression window (MIDI thread)
+    static constexpr int WINDOW_SIZE = 48;                 // Two beats
+    static constexpr int MIN_TICKS_FOR_REGRESSION = 6;
+    static constexpr double TEMPO_CHANGE_TOLERANCE = 0.25;  // Fraction of a tick period
+    static constexpr int TEMPO_CHANGE_TICKS = 3;           // Consecutive same-side outliers that refit
+    std::array<double, WINDOW_SIZE> tickTimes {};
+    int windowStart = 0;
+    int windowCount = 0;
+    
+    // Outliers held back from the fit until they prove to be a tempo change (MIDI thread)
+    std::array<double, TEMPO_CHANGE_TICKS> outlierTimes {};
+    int numOutliers = 0;
+    int outlierSide = 0;
+
+    // Transport state (MIDI thread)
+    bool running = false;
+    int64_t nextTick = 0;
+    int64_t lastTick = 0;
+    double fittedMsPerTick = 0.0;
+    double fittedLastTickTime = 0.0;
+    double residualJitter = 0.0;
+    double lastTickTime = 0.0;
+    uint32_t transportChanges = 0;
+
+    // Published snapshot (seqlock: odd while the MIDI thread is writing)
+    std::atomic<uint32_t> sequence { 0 };
+    std::atomic<bool> publishedRunning { false };
+    std::atomic<double> publishedMsPerTick { 0.0 };
+    std::atomic<double> publishedAnchorTime { 0.0 };
+    std::atomic<double> publishedAnchorTick { 0.0 };
+    std::atomic<double> publishedLastTickTime { 0.0 };
+    std::atomic<double> publishedJitter { 0.0 };
+    std::atomic<uint32_t> publishedTransportVersion { 0 };
+    std::atomic<uint32_t> updateCount { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiClockTracker)
+};
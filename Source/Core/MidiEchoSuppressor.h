@@ -0,0 +1,132 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+/**
+ * MidiEchoSuppressor recognises our own controller output coming back in through a MIDI
+ * loopback (virtual cable, a device with soft-thru, a DAW routing it back), so the input
+ * can drop exactly those messages instead of ignoring our whole output channel.
+ *
+ * The output side notes every controller message it puts on the wire. Each (channel, CC)
+ * keeps the last ENTRIES_PER_CONTROLLER sent values with their send times, packed into one
+ * atomic word apiece. An incoming message matching one of them within the echo window is
+ * an echo: the entry is consumed, so each sent message cancels at most one incoming one,
+ * and the lookup touches one small fixed row - O(1) on the MIDI thread, never locking.
+ * Anything else, including a different value on the same controller, passes.
+ */
+class MidiEchoSuppressor
+{
+public:
+    MidiEchoSuppressor() { reset(); }
+
+    // Output side (any thread)
+    void noteSent(int channel, int ccNumber, int value7bit, double timeMs) noexcept
+    {
+        if (!enabled.load(std::memory_order_relaxed) || !isValidController(channel, ccNumber))
+            return;
+
+        int row = getRow(channel, ccNumber);
+        int slot = nextEntry[(size_t)row].fetch_add(1, std::memory_order_relaxed) % ENTRIES_PER_CONTROLLER;
+        entries[(size_t)(row * ENTRIES_PER_CONTROLLER + slot)].store(pack(value7bit, timeMs), std::memory_order_release);
+    }
+
+    // Input side (MIDI thread) - true if the message is our own output coming back
+    bool isEcho(int channel, int ccNumber, int value7bit, double timeMs) noexcept
+    {
+        if (!enabled.load(std::memory_order_relaxed) || !isValidController(channel, ccNumber))
+            return false;
+
+        int row = getRow(channel, ccNumber);
+        auto incomingTime = toTicks(timeMs);
+        auto windowTicks = (uint32_t)juce::jmax(1, juce::roundToInt(windowMs.load(std::memory_order_relaxed)));
+
+        for (int i = 0; i < ENTRIES_PER_CONTROLLER; ++i)
+        {
+            auto& entry = entries[(size_t)(row * ENTRIES_PER_CONTROLLER + i)];
+            uint32_t packed = entry.load(std::memory_order_acquire);
+
+            if ((packed & VALID_BIT) == 0 || (int)(packed & VALUE_MASK) != (value7bit & 0x7F))
+                continue;
+
+            // Elapsed time since the send, in wrapping milliseconds. A message stamped a few
+            // ms before our send time still counts - scheduled sends note their due time.
+            uint32_t elapsed = (incomingTime - ((packed >> TIME_SHIFT) & TIME_MASK)) & TIME_MASK;
+            bool isRecent = elapsed <= windowTicks || TIME_MASK + 1 - elapsed <= EARLY_TOLERANCE_MS;
+            if (!isRecent)
+                continue;
+
+            // Consume the entry so one send cancels one echo
+            if (entry.compare_exchange_strong(packed, 0, std::memory_order_acq_rel))
+            {
+                suppressedEchoes.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void setEnabled(bool shouldSuppress) noexcept
+    {
+        enabled.store(shouldSuppress, std::memory_order_relaxed);
+        if (!shouldSuppress)
+            clearEntries();
+    }
+
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+    void setWindowMs(double milliseconds) noexcept { windowMs.store(juce::jlimit(1.0, MAX_WINDOW_MS, milliseconds), std::memory_order_relaxed); }
+    double getWindowMs() const noexcept { return windowMs.load(std::memory_order_relaxed); }
+
+    uint64_t getSuppressedEchoCount() const noexcept { return suppressedEchoes.load(std::memory_order_relaxed); }
+
+    void reset() noexcept
+    {
+        clearEntries();
+        suppressedEchoes.store(0, std::memory_order_relaxed);
+    }
+
+    static constexpr int ENTRIES_PER_CONTROLLER = 8;
+    static constexpr double DEFAULT_WINDOW_MS = 100.0;
+    static constexpr double MAX_WINDOW_MS = 1000.0;
+
+private:
+    // Entry layout: bits 0-6 value, 7-30 send time in ms (wraps every ~4.6 hours), 31 valid
+    static constexpr uint32_t VALUE_MASK = 0x7F;
+    static constexpr int TIME_SHIFT = 7;
+    static constexpr uint32_t TIME_MASK = 0xFFFFFF;
+    static constexpr uint32_t VALID_BIT = 1u << 31;
+    static constexpr uint32_t EARLY_TOLERANCE_MS = 5;
+    static constexpr int NUM_ROWS = 16 * 128;
+
+    static bool isValidController(int channel, int ccNumber) noexcept
+    {
+        return channel >= 1 && channel <= 16 && juce::isPositiveAndBelow(ccNumber, 128);
+    }
+
+    static int getRow(int channel, int ccNumber) noexcept { return (channel - 1) * 128 + ccNumber; }
+    static uint32_t toTicks(double timeMs) noexcept { return (uint32_t)((uint64_t)juce::jmax(0.0, timeMs) & TIME_MASK); }
+
+    static uint32_t pack(int value7bit, double timeMs) noexcept
+    {
+        return VALID_BIT | (toTicks(timeMs) << TIME_SHIFT) | (uint32_t)(value7bit & 0x7F);
+    }
+
+    void clearEntries() noexcept
+    {
+        for (auto& entry : entries)
+            entry.store(0, std::memory_order_relaxed);
+        for (auto& index : nextEntry)
+            index.store(0, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint32_t>, NUM_ROWS * ENTRIES_PER_CONTROLLER> entries;
+    std::array<std::atomic<uint8_t>, NUM_ROWS> nextEntry;
+    std::atomic<bool> enabled { true };
+    std::atomic<double> windowMs { DEFAULT_WINDOW_MS };
+    std::atomic<uint64_t> suppressedEchoes { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiEchoSuppressor)
+};
@@ -1,21 +1,43 @@
 #include "MidiManager.h"
+#include "CoreLog.h"
+#include "LatencyTracer.h"
 
 //==============================================================================
 MidiManager::MidiManager()
 {
-    DBG("MidiManager: Created");
+    // Every slider goes to every output until routed otherwise
+    for (auto& routing : sliderRouting)
+        routing.store(ALL_OUTPUT_PORTS, std::memory_order_relaxed);
+    
+    for (auto& parameter : sliderParameters)
+        parameter.store(0, std::memory_order_relaxed);
+    
+    for (auto& controller : sliderControllers)
+        controller.store(-1, std::memory_order_relaxed);
+    
+    // Sized once so draining the input FIFO never allocates
+    inputBatch.reserve(INPUT_QUEUE_SIZE);
+    
+    CORE_LOG_DEBUG("MidiManager", "Created");
 }
 
 MidiManager::~MidiManager()
 {
+    // Stop the output thread first so nothing touches the output ports during teardown
+    stopOutputThread();
+    
     // Stop MIDI devices
-    if (midiOutput)
-        midiOutput->stopBackgroundThread();
+    for (auto& port : outputPorts)
+        if (port->device)
+            port->device->stopBackgroundThread();
         
-    if (midiInput)
-        midiInput->stop();
+    for (auto& port : inputPorts)
+        port->device->stop();
+    
+    if (inputDispatchTimer)
+        inputDispatchTimer->stopTimer();
         
-    DBG("MidiManager: Destroyed");
+    CORE_LOG_DEBUG("MidiManager", "Destroyed");
 }
 
 //==============================================================================
@@ -27,43 +49,160 @@ void MidiManager::initializeDevices()
 
 void MidiManager::initializeOutput()
 {
-    auto midiDevices = juce::MidiOutput::getAvailableDevices();
+    // The first port is opened automatically - further ports are added with addOutputDevice()
+    if (outputPorts.empty())
+    {
+        auto midiDevices = juce::MidiOutput::getAvailableDevices();
+        
+        if (!midiDevices.isEmpty())
+        {
+            addOutputDevice(midiDevices[0].identifier);
+        }
+        else
+        {
+            // Create virtual MIDI output
+            addVirtualOutput("JUCE Virtual Controller");
+        }
+    }
     
-    if (!midiDevices.isEmpty())
+    startOutputThread();
+        
+    if (onDeviceConnectionChanged)
+        onDeviceConnectionChanged();
+}
+
+//==============================================================================
+int MidiManager::addOutputDevice(const juce::String& deviceIdentifier)
+{
+    auto port = std::make_unique<OutputPort>();
+    port->device = juce::MidiOutput::openDevice(deviceIdentifier);
+    return addOutputPort(std::move(port));
+}
+
+int MidiManager::addVirtualOutput(const juce::String& deviceName)
+{
+    auto port = std::make_unique<OutputPort>();
+    port->device = juce::MidiOutput::createNewDevice(deviceName);
+    return addOutputPort(std::move(port));
+}
+
+int MidiManager::addUmpOutput(std::unique_ptr<MidiUmpOutput> umpOutput)
+{
+    auto port = std::make_unique<OutputPort>();
+    port->umpDevice = std::move(umpOutput);
+    return addOutputPort(std::move(port));
+}
+
+int MidiManager::addOutputPort(std::unique_ptr<OutputPort> port)
+{
+    if ((!port->device && !port->umpDevice) || (int)outputPorts.size() >= MAX_OUTPUT_PORTS)
     {
-        midiOutput = juce::MidiOutput::openDevice(midiDevices[0].identifier);
+        CORE_LOG_WARNING("MidiManager", "Could not add output port");
+        return -1;
     }
-    else
+    
+    if (port->device)
+        port->device->startBackgroundThread();
+    
+    // A new receiver has no MSB or running status state yet - OutputPort starts clean
+    updateRunningStatus(*port);
+    
+    // The port list is read lock-free by the output thread, so only resize it while stopped
+    bool wasRunning = outputThread && outputThread->isThreadRunning();
+    stopOutputThread();
+    outputPorts.push_back(std::move(port));
+    numOutputPorts = (int)outputPorts.size();
+    if (wasRunning)
+        startOutputThread();
+    
+    CORE_LOG_DEBUG("MidiManager", "Added output port " << (numOutputPorts.load() - 1) << ": " << getOutputPortName(numOutputPorts.load() - 1));
+    
+    if (onDeviceConnectionChanged)
+        onDeviceConnectionChanged();
+    
+    return numOutputPorts.load() - 1;
+}
+
+void MidiManager::removeOutputPort(int portIndex)
+{
+    if (!juce::isPositiveAndBelow(portIndex, (int)outputPorts.size()))
+        return;
+    
+    bool wasRunning = outputThread && outputThread->isThreadRunning();
+    stopOutputThread();
+    
+    if (auto& device = outputPorts[(size_t)portIndex]->device)
+        device->stopBackgroundThread();
+    outputPorts.erase(outputPorts.begin() + portIndex);
+    numOutputPorts = (int)outputPorts.size();
+    
+    // Later ports moved down one index - move their routing bits with them
+    uint32_t lowerBits = (1u << portIndex) - 1;
+    for (auto& routing : sliderRouting)
     {
-        // Create virtual MIDI output
-        midiOutput = juce::MidiOutput::createNewDevice("JUCE Virtual Controller");
+        uint32_t mask = routing.load();
+        routing.store((mask & lowerBits) | ((mask >> 1) & ~lowerBits));
     }
     
-    if (midiOutput)
-        midiOutput->startBackgroundThread();
-        
+    if (wasRunning)
+        startOutputThread();
+    
+    CORE_LOG_DEBUG("MidiManager", "Removed output port " << portIndex);
+    
     if (onDeviceConnectionChanged)
         onDeviceConnectionChanged();
 }
 
+juce::String MidiManager::getOutputPortName(int portIndex) const
+{
+    if (auto* port = getOutputPort(portIndex))
+        return port->device ? port->device->getName() : port->umpDevice->getName();
+    return {};
+}
+
+void MidiManager::setSliderOutputRouting(int sliderNumber, uint32_t portMask)
+{
+    if (juce::isPositiveAndBelow(sliderNumber, (int)sliderRouting.size()))
+        sliderRouting[(size_t)sliderNumber].store(portMask, std::memory_order_relaxed);
+}
+
+uint32_t MidiManager::getSliderOutputRouting(int sliderNumber) const
+{
+    return getRoutingMask(sliderNumber);
+}
+
+uint32_t MidiManager::getRoutingMask(int sliderNumber) const
+{
+    if (juce::isPositiveAndBelow(sliderNumber, (int)sliderRouting.size()))
+        return sliderRouting[(size_t)sliderNumber].load(std::memory_order_relaxed);
+    return ALL_OUTPUT_PORTS;
+}
+
+MidiManager::OutputPort* MidiManager::getOutputPort(int portIndex) const
+{
+    if (juce::isPositiveAndBelow(portIndex, (int)outputPorts.size()))
+        return outputPorts[(size_t)portIndex].get();
+    return nullptr;
+}
+
 void MidiManager::initializeInput()
 {
     // Initialize MIDI input system
     // Actual device connection is handled by selectInputDevice()
-    DBG("MIDI Input system initialized. Use device selection to connect.");
+    CORE_LOG_DEBUG("MidiManager", "MIDI Input system initialized. Use device selection to connect.");
 }
 
 //==============================================================================
 void MidiManager::selectInputDevice(const juce::String& deviceName)
 {
-    DBG("Selecting MIDI input device: " << deviceName);
+    CORE_LOG_DEBUG("MidiManager", "Selecting MIDI input device: " << deviceName);
     
-    // Disconnect current device
-    if (midiInput)
+    // Disconnect the current primary device - other sources stay open
+    if (selectedInputSourceId >= 0)
     {
-        midiInput->stop();
-        midiInput.reset();
-        DBG("Disconnected previous MIDI input device");
+        removeInputSource(selectedInputSourceId);
+        selectedInputSourceId = -1;
+        CORE_LOG_DEBUG("MidiManager", "Disconnected previous MIDI input device");
     }
     
     // Handle "None" selection
@@ -73,7 +212,7 @@ void MidiManager::selectInputDevice(const juce::String& deviceName)
         if (onConnectionStatusChanged)
             onConnectionStatusChanged("None", true);
         saveDevicePreference();
-        DBG("MIDI input disabled");
+        CORE_LOG_DEBUG("MidiManager", "MIDI input disabled");
         return;
     }
     
@@ -87,28 +226,27 @@ void MidiManager::selectInputDevice(const juce::String& deviceName)
         {
             try
             {
-                midiInput = juce::MidiInput::openDevice(device.identifier, this);
+                selectedInputSourceId = addInputDevice(device.identifier);
                 
-                if (midiInput)
+                if (selectedInputSourceId >= 0)
                 {
-                    midiInput->start();
                     selectedMidiDeviceName = deviceName;
                     if (onConnectionStatusChanged)
                         onConnectionStatusChanged(deviceName, true);
                     saveDevicePreference();
                     deviceFound = true;
-                    DBG("Successfully connected to MIDI device: " << deviceName);
+                    CORE_LOG_DEBUG("MidiManager", "Successfully connected to MIDI device: " << deviceName);
                 }
                 else
                 {
                     if (onConnectionStatusChanged)
                         onConnectionStatusChanged(deviceName, false);
-                    DBG("Failed to open MIDI device: " << deviceName);
+                    CORE_LOG_WARNING("MidiManager", "Failed to open MIDI device: " << deviceName);
                 }
             }
             catch (const std::exception& e)
             {
-                DBG("Exception opening MIDI device " << deviceName << ": " << e.what());
+                CORE_LOG_WARNING("MidiManager", "Exception opening MIDI device " << deviceName << ": " << e.what());
                 if (onConnectionStatusChanged)
                     onConnectionStatusChanged(deviceName, false);
             }
@@ -118,7 +256,7 @@ void MidiManager::selectInputDevice(const juce::String& deviceName)
     
     if (!deviceFound)
     {
-        DBG("MIDI device not found: " << deviceName);
+        CORE_LOG_WARNING("MidiManager", "MIDI device not found: " << deviceName);
         if (onConnectionStatusChanged)
             onConnectionStatusChanged(deviceName + " (Not Found)", false);
     }
@@ -127,15 +265,161 @@ void MidiManager::selectInputDevice(const juce::String& deviceName)
         onDeviceConnectionChanged();
 }
 
+//==============================================================================
+int MidiManager::addInputDevice(const juce::String& deviceIdentifier)
+{
+    if ((int)inputPorts.size() >= MAX_INPUT_SOURCES)
+    {
+        CORE_LOG_WARNING("MidiManager", "Could not add input source - limit reached");
+        return -1;
+    }
+    
+    auto port = std::make_unique<InputPort>(*this, nextInputSourceId);
+    port->device = juce::MidiInput::openDevice(deviceIdentifier, port.get());
+    if (!port->device)
+    {
+        CORE_LOG_WARNING("MidiManager", "Could not open input " << deviceIdentifier);
+        return -1;
+    }
+    
+    port->name = port->device->getName();
+    port->rateWindowStart = juce::Time::getMillisecondCounterHiRes();
+    port->device->start();
+    inputPorts.push_back(std::move(port));
+    
+    if (!inputDispatchTimer)
+        inputDispatchTimer = std::make_unique<InputDispatchTimer>(*this);
+    if (!inputDispatchTimer->isTimerRunning())
+        inputDispatchTimer->startTimer(INPUT_DISPATCH_INTERVAL_MS);
+    
+    CORE_LOG_DEBUG("MidiManager", "Added input source " << nextInputSourceId << ": " << inputPorts.back()->name);
+    return nextInputSourceId++;
+}
+
+void MidiManager::removeInputSource(int sourceId)
+{
+    auto it = std::find_if(inputPorts.begin(), inputPorts.end(),
+                           [sourceId](const auto& port) { return port->sourceId == sourceId; });
+    if (it == inputPorts.end())
+        return;
+    
+    // No more callbacks after stop() - deliver what this source already queued while its
+    // name can still be resolved
+    (*it)->device->stop();
+    dispatchIncomingMidi();
+    inputPorts.erase(it);
+    
+    // Free the clock for the next source that sends one. The tracker belongs to the MIDI
+    // thread, so while other sources are open the next owner resets it on its own thread.
+    if (clockSourceId.load() == sourceId)
+    {
+        if (inputPorts.empty())
+            clockTracker.reset();
+        else
+            clockResetPending = true;
+        
+        clockSourceId = -1;
+        publishClockState();
+    }
+    
+    // Idle until a device is open again
+    if (inputPorts.empty() && inputDispatchTimer)
+        inputDispatchTimer->stopTimer();
+    
+    CORE_LOG_DEBUG("MidiManager", "Removed input source " << sourceId);
+}
+
+MidiManager::InputPort* MidiManager::findInputPort(int sourceId) const
+{
+    for (auto& port : inputPorts)
+        if (port->sourceId == sourceId)
+            return port.get();
+    
+    return nullptr;
+}
+
+std::vector<int> MidiManager::getInputSourceIds() const
+{
+    std::vector<int> sourceIds;
+    for (auto& port : inputPorts)
+        sourceIds.push_back(port->sourceId);
+    return sourceIds;
+}
+
+juce::String MidiManager::getInputSourceName(int sourceId) const
+{
+    auto* port = findInputPort(sourceId);
+    return port != nullptr ? port->name : juce::String();
+}
+
+void MidiManager::setInputSourceEnabled(int sourceId, bool shouldReceive)
+{
+    if (auto* port = findInputPort(sourceId))
+    {
+        port->enabled = shouldReceive;
+        port->decoder.reset();
+    }
+}
+
+bool MidiManager::isInputSourceEnabled(int sourceId) const
+{
+    auto* port = findInputPort(sourceId);
+    return port != nullptr && port->enabled.load();
+}
+
+void MidiManager::setInputSourceChannelMask(int sourceId, uint16_t channelMask)
+{
+    if (auto* port = findInputPort(sourceId))
+        port->channelMask = channelMask;
+}
+
+uint16_t MidiManager::getInputSourceChannelMask(int sourceId) const
+{
+    auto* port = findInputPort(sourceId);
+    return port != nullptr ? port->channelMask.load() : (uint16_t)0;
+}
+
+MidiManager::InputSourceStatistics MidiManager::getInputSourceStatistics(int sourceId) const
+{
+    InputSourceStatistics statistics;
+    
+    if (auto* port = findInputPort(sourceId))
+    {
+        statistics.receivedMessages = port->receivedMessages.load(std::memory_order_relaxed);
+        statistics.filteredMessages = port->filteredMessages.load(std::memory_order_relaxed);
+        statistics.deliveredEvents = port->deliveredEvents.load(std::memory_order_relaxed);
+        statistics.suppressedEchoes = port->suppressedEchoes.load(std::memory_order_relaxed);
+        statistics.messagesPerSecond = port->messagesPerSecond;
+    }
+    
+    return statistics;
+}
+
+uint64_t MidiManager::getPairedInputValueCount() const
+{
+    uint64_t total = 0;
+    for (auto& port : inputPorts)
+        total += port->decoder.getPairedValueCount();
+    return total;
+}
+
+uint64_t MidiManager::getUnpairedInputValueCount() const
+{
+    uint64_t total = 0;
+    for (auto& port : inputPorts)
+        total += port->decoder.getUnpairedValueCount();
+    return total;
+}
+
 //==============================================================================
 bool MidiManager::isOutputConnected() const
 {
-    return midiOutput != nullptr;
+    return numOutputPorts.load() > 0;
 }
 
 bool MidiManager::isInputConnected() const
 {
-    return midiInput != nullptr;
+    return selectedInputSourceId >= 0;
 }
 
 juce::String MidiManager::getSelectedDeviceName() const
@@ -146,52 +430,724 @@ juce::String MidiManager::getSelectedDeviceName() const
 //==============================================================================
 void MidiManager::sendCC14Bit(int channel, int ccNumber, int value14bit)
 {
-    if (!midiOutput) return;
+    if (numOutputPorts.load() == 0) return;
     
-    // Convert 14-bit value to MSB and LSB
-    int msb = (value14bit >> 7) & 0x7F;
-    int lsb = value14bit & 0x7F;
+    // Slider number 0 = no slider, not reported to the MIDI monitor
+    pushOutputEvent(MidiOutputEvent::make(0, channel, ccNumber, value14bit));
+    LatencyTracer::getInstance().markSend();
+}
+
+void MidiManager::pushOutputEvent(const MidiOutputEvent& event)
+{
+    outputQueue.push(event);
     
-    // Send MSB
-    juce::MidiMessage msbMessage = juce::MidiMessage::controllerEvent(channel, ccNumber, msb);
-    midiOutput->sendMessageNow(msbMessage);
+    // Wake an idle output thread. Pairs with the fence in OutputThread::run(): either the
+    // thread sees this event before it sleeps, or this sees it idle and signals it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (outputThreadIdle.load(std::memory_order_relaxed) && outputThreadIdle.exchange(false))
+        outputThread->notify();
+}
+
+void MidiManager::sendCC14BitWithSlider(int sliderNumber, int channel, int ccNumber, int value14bit,
+                                        MidiOutputPriority priority, bool shouldSmooth)
+{
+    if (numOutputPorts.load() == 0) return;
     
-    // Send LSB
-    if (ccNumber < 96)
+    // Never blocks - the output thread picks the event up on its next tick, or wakes for it
+    int parameter = getSliderParameterKey(sliderNumber);
+    auto event = parameter != 0
+        ? MidiOutputEvent::makeParameter(sliderNumber, channel, (MidiParameterType)(parameter >> 14),
+                                         parameter & 0x3FFF, value14bit, priority)
+        : MidiOutputEvent::make(sliderNumber, channel, ccNumber, value14bit, priority);
+    
+    pushOutputEvent(shouldSmooth ? event.withSmoothing() : event);
+    
+    LatencyTracer::getInstance().markSend();
+}
+
+void MidiManager::setSliderController(int sliderNumber, int channel, int ccNumber)
+{
+    if (juce::isPositiveAndBelow(sliderNumber, (int)sliderControllers.size()))
+        sliderControllers[(size_t)sliderNumber].store(((juce::jlimit(1, 16, channel) - 1) << 7) | (ccNumber & 0x7F),
+                                                     std::memory_order_relaxed);
+}
+
+void MidiManager::sendSliderValue(int sliderNumber, int value14bit, MidiOutputPriority priority)
+{
+    if (!juce::isPositiveAndBelow(sliderNumber, (int)sliderControllers.size()))
+        return;
+    
+    int controller = sliderControllers[(size_t)sliderNumber].load(std::memory_order_relaxed);
+    if (controller >= 0)
+        sendCC14BitWithSlider(sliderNumber, (controller >> 7) + 1, controller & 0x7F, value14bit, priority);
+}
+
+void MidiManager::scheduleCC14BitBlock(int sliderNumber, int channel, int ccNumber, const std::vector<ScheduledCCValue>& values)
+{
+    if (outputPorts.empty() || values.empty()) return;
+    
+    // Points that are already due go out at the start of the block
+    double startTime = juce::jmax(values.front().timeMs, juce::Time::getMillisecondCounterHiRes());
+    
+    // NRPN/RPN sliders re-select their parameter on every point - the output thread
+    // may select a different one on the same channel between two scheduled points
+    int parameter = getSliderParameterKey(sliderNumber);
+    auto parameterType = (MidiParameterType)(parameter >> 14);
+    
+    uint32_t routing = getRoutingMask(sliderNumber);
+    
+    ControllerMessages messages;
+    int value14bit = juce::jlimit(0, 16383, values.back().value14bit);
+    
+    // Each port thins the block to its own budget, so the same point may leave two ports
+    // at different times - note every distinct send time for echo suppression only once
+    std::vector<double> notedTimes(values.size(), -1.0);
+    
+    for (size_t portIndex = 0; portIndex < outputPorts.size(); ++portIndex)
+    {
+        if ((routing & (1u << portIndex)) == 0)
+            continue;
+        
+        auto& port = *outputPorts[portIndex];
+        
+        // Scheduled messages bypass the output thread, so its per-receiver state is stale:
+        // the MSB for this controller, or the channel's selected parameter until the block ends
+        if (parameter != 0)
+        {
+            auto& externalUntil = port.parameterStates[(size_t)((channel - 1) & 0x0F)].externalUntil;
+            externalUntil.store(juce::jmax(externalUntil.load(), values.back().timeMs));
+        }
+        else
+        {
+            port.msbStates[(size_t)(((channel - 1) & 0x0F) * 128 + (ccNumber & 0x7F))].lastSentMsb.store(-1);
+        }
+        
+        juce::MidiBuffer block;
+        
+        for (size_t pointIndex = 0; pointIndex < values.size(); ++pointIndex)
+        {
+            int pointValue = juce::jlimit(0, 16383, values[pointIndex].value14bit);
+            int numMessages = 0;
+            
+            if (parameter != 0)
+            {
+                numMessages = getParameterMessages(parameterType, parameter & 0x3FFF, pointValue, true, messages);
+            }
+            else
+            {
+                messages[0] = { ccNumber, (pointValue >> 7) & 0x7F };
+                messages[1] = { ccNumber + 32, pointValue & 0x7F };
+                numMessages = ccNumber < 96 ? 2 : 1;
+            }
+            
+            int bytes = port.encoder.getRunSize(numMessages, 3);
+            if (port.umpDevice)
+                bytes = parameter == 0 && sendsMidi2Packets(*port.umpDevice)
+                            ? MidiUmpEncoder::CONTROL_CHANGE_V2_BYTES
+                            : numMessages * MidiUmpEncoder::CONTROL_CHANGE_V1_BYTES;
+            
+            // Reserve wire time before queueing - intermediate points that don't fit the
+            // port's budget are dropped, the final value is moved to the next free slot
+            double dueTime = port.budget.reserveScheduled(juce::jmax(startTime, values[pointIndex].timeMs),
+                                                          bytes, pointIndex == values.size() - 1);
+            if (dueTime < 0.0)
+                continue;
+            
+            if (port.umpDevice)
+            {
+                // UMP endpoints take timestamped packets and note their own echoes
+                if (parameter == 0)
+                {
+                    sendUmpController(*port.umpDevice, channel, ccNumber, pointValue, dueTime);
+                    continue;
+                }
+                
+                for (int i = 0; i < numMessages; ++i)
+                    sendUmpController7(*port.umpDevice, channel, messages[(size_t)i].first, messages[(size_t)i].second, dueTime);
+                continue;
+            }
+            
+            int samplePosition = (int)std::round((dueTime - startTime) * SCHEDULE_SAMPLES_PER_SECOND / 1000.0);
+            bool noteEcho = notedTimes[pointIndex] != dueTime;
+            notedTimes[pointIndex] = dueTime;
+            
+            for (int i = 0; i < numMessages; ++i)
+            {
+                block.addEvent(juce::MidiMessage::controllerEvent(channel, messages[(size_t)i].first, messages[(size_t)i].second), samplePosition);
+                if (noteEcho)
+                    echoSuppressor.noteSent(channel, messages[(size_t)i].first, messages[(size_t)i].second, dueTime);
+            }
+        }
+        
+        if (port.device == nullptr)
+            continue;
+        
+        port.device->sendBlockOfMessages(block, startTime, SCHEDULE_SAMPLES_PER_SECOND);
+        
+        // The block's messages interleave with ours, so our next message needs a fresh status byte
+        port.encoder.invalidateRunningStatus();
+    }
+    
+    // Notify MIDI monitor once per block with the last scheduled value
+    notifyMidiSent(sliderNumber, channel, ccNumber, value14bit);
+}
+
+void MidiManager::cancelScheduledOutput()
+{
+    double now = juce::Time::getMillisecondCounterHiRes();
+    
+    for (auto& port : outputPorts)
+    {
+        if (port->device)
+            port->device->clearAllPendingMessages();
+        else
+            port->umpDevice->clearPendingPackets();
+        
+        // The cleared messages no longer need their wire time
+        port->budget.clearScheduled(now);
+    }
+}
+
+//==============================================================================
+MidiManager::OutputThread::OutputThread(MidiManager& ownerToUse)
+    : juce::Thread("VMC14 MIDI Output"), owner(ownerToUse)
+{
+}
+
+void MidiManager::OutputThread::run()
+{
+    while (!threadShouldExit())
+    {
+        // One flush pass per tick: everything queued since the last pass is coalesced
+        owner.drainOutputQueue();
+        owner.advanceSmoothedOutput();
+        owner.flushCoalescedOutput();
+        
+        if (owner.hasPendingOutput())
+        {
+            // Tick at the smoothing rate while a slider is gliding
+            int tickMs = owner.outputTickMs.load();
+            if (owner.outputSmoother.isMoving())
+                tickMs = juce::jmin(tickMs, owner.outputSmoother.getTickIntervalMs());
+            wait(tickMs);
+            continue;
+        }
+        
+        // Nothing left to send - sleep until a producer pushes. A push that lands between
+        // the check and wait() has already signalled, so wait() returns straight away.
+        owner.outputThreadIdle.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (owner.outputQueue.isEmpty())
+            wait(-1);
+        owner.outputThreadIdle.store(false);
+    }
+    
+    // Flush anything queued right before shutdown
+    owner.drainOutputQueue();
+    owner.flushCoalescedOutput();
+}
+
+bool MidiManager::hasPendingOutput() const
+{
+    if (outputSmoother.isMoving())
+        return true;
+    
+    // Events held back by a port's budget go out on later ticks
+    for (auto& port : outputPorts)
+        if (port->coalescer.hasPendingEvents())
+            return true;
+    
+    return false;
+}
+
+void MidiManager::startOutputThread()
+{
+    if (!outputThread)
+        outputThread = std::make_unique<OutputThread>(*this);
+    
+    if (!outputThread->isThreadRunning())
+    {
+        outputThread->startThread(outputThreadPriority);
+        CORE_LOG_DEBUG("MidiManager", "Output thread started");
+    }
+}
+
+void MidiManager::stopOutputThread()
+{
+    if (outputThread)
+    {
+        outputThread->stopThread(500);
+        CORE_LOG_DEBUG("MidiManager", "Output thread stopped");
+    }
+}
+
+void MidiManager::setOutputThreadPriority(juce::Thread::Priority priority)
+{
+    if (outputThreadPriority == priority)
+        return;
+    
+    outputThreadPriority = priority;
+    
+    // JUCE threads take their priority at start, so restart a running thread
+    if (outputThread && outputThread->isThreadRunning())
     {
-        juce::MidiMessage lsbMessage = juce::MidiMessage::controllerEvent(channel, ccNumber + 32, lsb);
-        midiOutput->sendMessageNow(lsbMessage);
+        stopOutputThread();
+        startOutputThread();
     }
 }
 
-void MidiManager::sendCC14BitWithSlider(int sliderNumber, int channel, int ccNumber, int value14bit)
+void MidiManager::drainOutputQueue()
 {
-    if (!midiOutput) return;
+    MidiOutputEvent event;
+    bool shouldCoalesce = coalescingEnabled.load();
+    bool shouldSmooth = outputSmoothingEnabled.load();
+    double now = juce::Time::getMillisecondCounterHiRes();
+    
+    while (outputQueue.pop(event))
+    {
+        if (shouldSmooth && event.isSmoothingRequested())
+        {
+            outputSmoother.setTarget(event, now, [this, shouldCoalesce](const MidiOutputEvent& smoothed) {
+                routeOutputEvent(smoothed, shouldCoalesce);
+            });
+            continue;
+        }
+        
+        outputSmoother.setResting(event);
+        routeOutputEvent(event, shouldCoalesce);
+    }
+}
+
+void MidiManager::routeOutputEvent(const MidiOutputEvent& event, bool shouldCoalesce)
+{
+    // Fan out to every routed port - the monitor is told about the first one only
+    uint32_t routing = getRoutingMask(event.getSliderNumber());
+    bool notifyMonitor = true;
+    
+    for (size_t portIndex = 0; portIndex < outputPorts.size(); ++portIndex)
+    {
+        if ((routing & (1u << portIndex)) == 0)
+            continue;
+        
+        auto& port = *outputPorts[portIndex];
+        
+        // A paced port must be able to hold events back, which only the coalescer can do
+        if (shouldCoalesce || port.budget.isLimited())
+            port.coalescer.add(event);
+        else
+            sendEventNow(port, event, notifyMonitor);
+        
+        notifyMonitor = false;
+    }
+}
+
+void MidiManager::advanceSmoothedOutput()
+{
+    bool shouldCoalesce = coalescingEnabled.load();
+    outputSmoother.advance(juce::Time::getMillisecondCounterHiRes(), [this, shouldCoalesce](const MidiOutputEvent& smoothed) {
+        routeOutputEvent(smoothed, shouldCoalesce);
+    });
+}
+
+void MidiManager::flushCoalescedOutput()
+{
+    double now = juce::Time::getMillisecondCounterHiRes();
+    
+    for (size_t portIndex = 0; portIndex < outputPorts.size(); ++portIndex)
+    {
+        auto& port = *outputPorts[portIndex];
+        port.budget.refill(now);
+        
+        if (!port.coalescer.hasPendingEvents())
+            continue;
+        
+        if (port.encoder.isRunningStatusEnabled())
+            port.coalescer.sortPendingByChannel();
+        
+        // One pass per priority class so manual moves get the budget first.
+        // Also drains leftovers if coalescing was switched off mid-tick.
+        for (auto priority : { MidiOutputPriority::Manual, MidiOutputPriority::Automation, MidiOutputPriority::Bulk })
+        {
+            port.coalescer.flush([this, &port, portIndex, priority](const MidiOutputEvent& event) {
+                if (event.getPriority() != priority)
+                    return false;
+                
+                // Report to the monitor from the lowest port this slider is routed to
+                uint32_t routing = getRoutingMask(event.getSliderNumber());
+                bool notifyMonitor = (routing & ((1u << portIndex) - 1)) == 0;
+                return sendEventNow(port, event, notifyMonitor);
+            });
+        }
+    }
+}
+
+bool MidiManager::sendEventNow(OutputPort& port, const MidiOutputEvent& event, bool notifyMonitor)
+{
+    if (event.isParameterEvent())
+        return sendParameterEventNow(port, event, notifyMonitor);
+    
+    // A plain CC on 98-101 moves the receiver's parameter select
+    if (event.getCCNumber() >= 98 && event.getCCNumber() <= 101)
+        port.parameterStates[(size_t)(event.getChannel() - 1)].selected = -1;
+    
+    if (port.umpDevice)
+        return sendUmpEventNow(port, event, notifyMonitor);
+    
+    int channel = event.getChannel();
+    int ccNumber = event.getCCNumber();
+    int value14bit = event.getValue14Bit();
+    int sliderNumber = event.getSliderNumber();
     
     // Convert 14-bit value to MSB and LSB
     int msb = (value14bit >> 7) & 0x7F;
     int lsb = value14bit & 0x7F;
+    bool hasLsb = ccNumber < 96;
     
-    // Send MSB
     juce::MidiMessage msbMessage = juce::MidiMessage::controllerEvent(channel, ccNumber, msb);
-    midiOutput->sendMessageNow(msbMessage);
+    juce::MidiMessage lsbMessage = juce::MidiMessage::controllerEvent(channel, ccNumber + 32, lsb);
+    
+    // Budget for the worst case (MSB not elided) - the pair stays pending if it does not fit
+    int pairSize = hasLsb ? port.encoder.getPairSize(msbMessage, lsbMessage) : port.encoder.getMessageSize(msbMessage);
+    if (!port.budget.canSend(pairSize, event.getPriority()))
+    {
+        port.budget.noteDeferred();
+        return false;
+    }
+    
+    double now = juce::Time::getMillisecondCounterHiRes();
+    
+    // Send MSB (unless the receiver already holds it and elision is on)
+    if (hasLsb && canElideMsb(port, channel, ccNumber, msb, now))
+    {
+        elidedMsbCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        echoSuppressor.noteSent(channel, ccNumber, msb, now);
+        port.device->sendMessageNow(msbMessage);
+        port.budget.consume(port.encoder.encode(msbMessage));
+    }
     
     // Send LSB
-    if (ccNumber < 96)
+    if (hasLsb)
     {
-        juce::MidiMessage lsbMessage = juce::MidiMessage::controllerEvent(channel, ccNumber + 32, lsb);
-        midiOutput->sendMessageNow(lsbMessage);
+        echoSuppressor.noteSent(channel, ccNumber + 32, lsb, now);
+        port.device->sendMessageNow(lsbMessage);
+        port.budget.consume(port.encoder.encode(lsbMessage));
     }
     
     // Notify MIDI monitor of outgoing message
-    if (onMidiSent)
+    if (notifyMonitor)
+        notifyMidiSent(sliderNumber, channel, ccNumber, value14bit);
+    
+    return true;
+}
+
+bool MidiManager::sendUmpEventNow(OutputPort& port, const MidiOutputEvent& event, bool notifyMonitor)
+{
+    int channel = event.getChannel();
+    int ccNumber = event.getCCNumber();
+    int value14bit = event.getValue14Bit();
+    
+    // One 64-bit packet in MIDI 2.0 mode, otherwise one 32-bit packet per MIDI 1.0 message
+    int packetBytes = sendsMidi2Packets(*port.umpDevice)
+                    ? MidiUmpEncoder::CONTROL_CHANGE_V2_BYTES
+                    : MidiUmpEncoder::CONTROL_CHANGE_V1_BYTES * (ccNumber < 96 ? 2 : 1);
+    if (!port.budget.canSend(packetBytes, event.getPriority()))
+    {
+        port.budget.noteDeferred();
+        return false;
+    }
+    
+    port.budget.consume(sendUmpController(*port.umpDevice, channel, ccNumber, value14bit, 0.0));
+    
+    if (notifyMonitor)
+        notifyMidiSent(event.getSliderNumber(), channel, ccNumber, value14bit);
+    
+    return true;
+}
+
+int MidiManager::sendUmpController(MidiUmpOutput& umpOutput, int channel, int ccNumber, int value14bit, double timeMs)
+{
+    value14bit = juce::jlimit(0, 16383, value14bit);
+    
+    if (sendsMidi2Packets(umpOutput))
+    {
+        // A MIDI 1.0 receiver on the loop sees the downconverted MSB/LSB pair
+        double sentTime = timeMs > 0.0 ? timeMs : juce::Time::getMillisecondCounterHiRes();
+        echoSuppressor.noteSent(channel, ccNumber, value14bit >> 7, sentTime);
+        if (ccNumber < 96)
+            echoSuppressor.noteSent(channel, ccNumber + 32, value14bit & 0x7F, sentTime);
+        
+        auto packet = MidiUmpEncoder::makeControlChange(channel, ccNumber, value14bit);
+        umpOutput.sendPacket(packet.data(), 2, timeMs);
+        umpPacketCount.fetch_add(1, std::memory_order_relaxed);
+        return MidiUmpEncoder::CONTROL_CHANGE_V2_BYTES;
+    }
+    
+    // MIDI 1.0 protocol in UMP: the same MSB/LSB pair, one packet each
+    int bytes = sendUmpController7(umpOutput, channel, ccNumber, value14bit >> 7, timeMs);
+    
+    if (ccNumber < 96)
+        bytes += sendUmpController7(umpOutput, channel, ccNumber + 32, value14bit & 0x7F, timeMs);
+    
+    return bytes;
+}
+
+bool MidiManager::sendsMidi2Packets(const MidiUmpOutput& umpOutput) const
+{
+    return umpOutputEnabled.load(std::memory_order_relaxed) && umpOutput.carriesMidi2Protocol();
+}
+
+bool MidiManager::hasMidi2Output() const
+{
+    for (int portIndex = 0; portIndex < numOutputPorts.load(); ++portIndex)
+        if (auto* port = getOutputPort(portIndex))
+            if (port->umpDevice && port->umpDevice->carriesMidi2Protocol())
+                return true;
+    return false;
+}
+
+int MidiManager::sendUmpController7(MidiUmpOutput& umpOutput, int channel, int ccNumber, int value7bit, double timeMs)
+{
+    echoSuppressor.noteSent(channel, ccNumber, value7bit, timeMs > 0.0 ? timeMs : juce::Time::getMillisecondCounterHiRes());
+    
+    auto packet = MidiUmpEncoder::makeMidi1ControlChange(channel, ccNumber, value7bit);
+    umpOutput.sendPacket(packet.data(), 1, timeMs);
+    umpPacketCount.fetch_add(1, std::memory_order_relaxed);
+    return MidiUmpEncoder::CONTROL_CHANGE_V1_BYTES;
+}
+
+//==============================================================================
+bool MidiManager::sendParameterEventNow(OutputPort& port, const MidiOutputEvent& event, bool notifyMonitor)
+{
+    int channel = event.getChannel();
+    int value14bit = event.getValue14Bit();
+    auto type = event.getParameterType();
+    int parameterNumber = event.getParameterNumber();
+    int parameterKey = ((int)type << 14) | parameterNumber;
+    
+    // Skip the select when this receiver's channel already points at the parameter
+    auto& state = port.parameterStates[(size_t)(channel - 1)];
+    bool needsSelect = state.selected != parameterKey
+                    || juce::Time::getMillisecondCounterHiRes() <= state.externalUntil.load(std::memory_order_relaxed);
+    
+    ControllerMessages messages;
+    int numMessages = getParameterMessages(type, parameterNumber, value14bit, needsSelect, messages);
+    
+    int worstCaseBytes = port.umpDevice ? numMessages * MidiUmpEncoder::CONTROL_CHANGE_V1_BYTES
+                                        : port.encoder.getRunSize(numMessages, 3);
+    if (!port.budget.canSend(worstCaseBytes, event.getPriority()))
+    {
+        port.budget.noteDeferred();
+        return false;
+    }
+    
+    for (int i = 0; i < numMessages; ++i)
+        port.budget.consume(sendController7Now(port, channel, messages[(size_t)i].first, messages[(size_t)i].second));
+    
+    state.selected = parameterKey;
+    if (!needsSelect)
+        skippedParameterSelects.fetch_add(1, std::memory_order_relaxed);
+    
+    // The monitor shows parameter updates as data entry (CC 6)
+    if (notifyMonitor)
+        notifyMidiSent(event.getSliderNumber(), channel, 6, value14bit);
+    
+    return true;
+}
+
+int MidiManager::sendController7Now(OutputPort& port, int channel, int ccNumber, int value7bit)
+{
+    if (port.umpDevice)
+        return sendUmpController7(*port.umpDevice, channel, ccNumber, value7bit, 0.0);
+    
+    echoSuppressor.noteSent(channel, ccNumber, value7bit, juce::Time::getMillisecondCounterHiRes());
+    
+    auto message = juce::MidiMessage::controllerEvent(channel, ccNumber, value7bit);
+    port.device->sendMessageNow(message);
+    return port.encoder.encode(message);
+}
+
+int MidiManager::getParameterMessages(MidiParameterType type, int parameterNumber, int value14bit,
+                                      bool includeSelect, ControllerMessages& messages)
+{
+    int numMessages = 0;
+    
+    if (includeSelect)
+    {
+        bool isRpn = type == MidiParameterType::Rpn;
+        messages[(size_t)numMessages++] = { isRpn ? 101 : 99, (parameterNumber >> 7) & 0x7F };
+        messages[(size_t)numMessages++] = { isRpn ? 100 : 98, parameterNumber & 0x7F };
+    }
+    
+    // Data entry MSB then LSB
+    messages[(size_t)numMessages++] = { 6, (value14bit >> 7) & 0x7F };
+    messages[(size_t)numMessages++] = { 38, value14bit & 0x7F };
+    return numMessages;
+}
+
+void MidiManager::setSliderParameter(int sliderNumber, MidiParameterType type, int parameterNumber)
+{
+    if (!juce::isPositiveAndBelow(sliderNumber, (int)sliderParameters.size()))
+        return;
+    
+    int key = type == MidiParameterType::ControlChange ? 0
+                                                       : ((int)type << 14) | juce::jlimit(0, 16383, parameterNumber);
+    sliderParameters[(size_t)sliderNumber].store(key, std::memory_order_relaxed);
+}
+
+MidiParameterType MidiManager::getSliderParameterType(int sliderNumber) const
+{
+    return (MidiParameterType)(getSliderParameterKey(sliderNumber) >> 14);
+}
+
+int MidiManager::getSliderParameterNumber(int sliderNumber) const
+{
+    return getSliderParameterKey(sliderNumber) & 0x3FFF;
+}
+
+int MidiManager::getSliderParameterKey(int sliderNumber) const
+{
+    if (juce::isPositiveAndBelow(sliderNumber, (int)sliderParameters.size()))
+        return sliderParameters[(size_t)sliderNumber].load(std::memory_order_relaxed);
+    return 0;
+}
+
+void MidiManager::notifyMidiSent(int sliderNumber, int channel, int ccNumber, int value14bit)
+{
+    // One relaxed load when no monitor is attached - no allocation, no message thread post
+    if (sliderNumber <= 0 || !monitorAttached.load(std::memory_order_relaxed))
+        return;
+    
+    monitorQueue.push({ sliderNumber, channel, ccNumber, value14bit });
+}
+
+void MidiManager::setMonitorAttached(bool isAttached)
+{
+    monitorAttached = isAttached;
+    
+    // Discard anything left over from the last time the monitor was open
+    if (isAttached)
+    {
+        OutgoingMonitorEvent stale;
+        while (monitorQueue.pop(stale)) {}
+    }
+}
+
+bool MidiManager::canElideMsb(OutputPort& port, int channel, int ccNumber, int msb, double now)
+{
+    auto& state = port.msbStates[(size_t)(((channel - 1) & 0x0F) * 128 + (ccNumber & 0x7F))];
+    
+    // Receivers keep the last MSB and accept LSB-only updates (MIDI 1.0 spec),
+    // but periodically resend the full pair in case one was lost or the receiver restarted
+    if (msbElisionEnabled.load(std::memory_order_relaxed)
+        && state.lastSentMsb.load(std::memory_order_relaxed) == msb
+        && now - state.lastFullPairTime < MSB_REFRESH_INTERVAL_MS)
+        return true;
+    
+    state.lastSentMsb.store(msb, std::memory_order_relaxed);
+    state.lastFullPairTime = now;
+    return false;
+}
+
+void MidiManager::setMsbElisionEnabled(bool shouldElide)
+{
+    if (msbElisionEnabled == shouldElide)
+        return;
+    
+    // Start from a clean slate so the first update after enabling is a full pair
+    invalidateMsbCache();
+    msbElisionEnabled = shouldElide;
+    CORE_LOG_DEBUG("MidiManager", "MSB elision " << (shouldElide ? "enabled" : "disabled"));
+}
+
+void MidiManager::invalidateMsbCache()
+{
+    for (auto& port : outputPorts)
+        for (auto& state : port->msbStates)
+            state.lastSentMsb.store(-1, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void MidiManager::setRunningStatusEnabled(bool useRunningStatus)
+{
+    runningStatusEnabled = useRunningStatus;
+    
+    for (auto& port : outputPorts)
+        updateRunningStatus(*port);
+}
+
+void MidiManager::updateRunningStatus(OutputPort& port)
+{
+    // Dropped status bytes only save wire time when the backend writes the bytes as we
+    // size them and a paced link (a baud rate is set) is there to spend the saving
+    port.encoder.setRunningStatusEnabled(runningStatusEnabled && port.writesRawBytes && port.budget.isLimited());
+}
+
+uint64_t MidiManager::getRunningStatusSavedByteCount() const
+{
+    uint64_t total = 0;
+    for (auto& port : outputPorts)
+        total += port->encoder.getRunningStatusSavedByteCount();
+    return total;
+}
+
+uint64_t MidiManager::getCoalescedEventCount() const
+{
+    uint64_t total = 0;
+    for (auto& port : outputPorts)
+        total += port->coalescer.getCoalescedEventCount();
+    return total;
+}
+
+uint64_t MidiManager::getCoalescedMessageCount() const
+{
+    uint64_t total = 0;
+    for (auto& port : outputPorts)
+        total += port->coalescer.getCoalescedMessageCount();
+    return total;
+}
+
+void MidiManager::setWireBaudRate(int portIndex, int baud)
+{
+    if (auto* port = getOutputPort(portIndex))
     {
-        juce::MessageManager::callAsync([this, sliderNumber, channel, ccNumber, msb, lsb, value14bit]() {
-            onMidiSent(sliderNumber, channel, ccNumber, msb, lsb, value14bit);
-        });
+        port->budget.setBaudRate(baud);
+        updateRunningStatus(*port);
     }
 }
 
+int MidiManager::getWireBaudRate(int portIndex) const
+{
+    auto* port = getOutputPort(portIndex);
+    return port != nullptr ? port->budget.getBaudRate() : 0;
+}
+
+float MidiManager::getWireUtilization(int portIndex) const
+{
+    auto* port = getOutputPort(portIndex);
+    return port != nullptr ? port->budget.getUtilization() : 0.0f;
+}
+
+double MidiManager::getWireBytesPerSecond(int portIndex) const
+{
+    auto* port = getOutputPort(portIndex);
+    return port != nullptr ? port->budget.getBytesPerSecond() : 0.0;
+}
+
+uint64_t MidiManager::getDeferredOutputEventCount(int portIndex) const
+{
+    auto* port = getOutputPort(portIndex);
+    return port != nullptr ? port->budget.getDeferredEventCount() : 0;
+}
+
+uint64_t MidiManager::getWireByteCount(int portIndex) const
+{
+    auto* port = getOutputPort(portIndex);
+    return port != nullptr ? port->budget.getTotalBytesSent() : 0;
+}
+
 // sendCC7BitWithSlider method removed as part of 7-bit mode cleanup
 // System now always uses sendCC14BitWithSlider for universal compatibility
 
@@ -215,11 +1171,11 @@ void MidiManager::saveDevicePreference()
     try
     {
         prefFile.replaceWithText(selectedMidiDeviceName);
-        DBG("Saved MIDI device preference: " << selectedMidiDeviceName);
+        CORE_LOG_DEBUG("MidiManager", "Saved MIDI device preference: " << selectedMidiDeviceName);
     }
     catch (const std::exception& e)
     {
-        DBG("Failed to save MIDI device preference: " << e.what());
+        CORE_LOG_WARNING("MidiManager", "Failed to save MIDI device preference: " << e.what());
     }
 }
 
@@ -243,7 +1199,7 @@ void MidiManager::loadDevicePreference()
         if (savedDevice.isNotEmpty())
         {
             selectedMidiDeviceName = savedDevice;
-            DBG("Loaded MIDI device preference: " << savedDevice);
+            CORE_LOG_DEBUG("MidiManager", "Loaded MIDI device preference: " << savedDevice);
             
             // The parent controller will need to handle UI updates
             selectInputDevice(savedDevice);
@@ -251,37 +1207,222 @@ void MidiManager::loadDevicePreference()
     }
     else
     {
-        DBG("No saved MIDI device preference found");
+        CORE_LOG_DEBUG("MidiManager", "No saved MIDI device preference found");
     }
 }
 
 //==============================================================================
-void MidiManager::handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message)
+void MidiManager::handleIncomingMidiMessage(InputPort& port, const juce::MidiMessage& message)
 {
+    double now = juce::Time::getMillisecondCounterHiRes();
+    
+    // JUCE stamps input with getMillisecondCounterHiRes() * 0.001
+    double timeMs = message.getTimeStamp() > 0.0 ? message.getTimeStamp() * 1000.0 : now;
+    
+    port.receivedMessages.fetch_add(1, std::memory_order_relaxed);
+    
+    // Filter here, before anything is queued for the message thread
+    if (!port.enabled.load(std::memory_order_relaxed))
+    {
+        port.filteredMessages.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    if (handleIncomingClockMessage(port, message, timeMs))
+        return;
+    
     if (message.isController())
     {
         int channel = message.getChannel();
-        int ccNumber = message.getControllerNumber();
-        int ccValue = message.getControllerValue();
+        if ((port.channelMask.load(std::memory_order_relaxed) & (1u << (channel - 1))) == 0)
+        {
+            port.filteredMessages.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        
+        // Our own output coming back through a loopback - drop just that message
+        if (echoSuppressor.isEcho(channel, message.getControllerNumber(), message.getControllerValue(), timeMs))
+        {
+            port.suppressedEchoes.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
         
         // Update activity indicator
         midiInputActivity = true;
-        lastMidiInputTime = juce::Time::getMillisecondCounterHiRes();
+        lastMidiInputTime = now;
         
-        // Notify parent component about received MIDI
-        if (onMidiReceived)
+        // No allocation and no message thread post - the frame timer picks it up
+        if (highResolutionInputEnabled.load(std::memory_order_relaxed))
+        {
+            port.decoder.process(channel, message.getControllerNumber(), message.getControllerValue(), timeMs,
+                                 [this, &port](const Midi14BitDecoder::DecodedValue& decoded) { pushIncomingEvent(port, decoded); });
+        }
+        else
+        {
+            int value = message.getControllerValue();
+            pushIncomingEvent(port, { channel, message.getControllerNumber(), value << 7, false, timeMs });
+        }
+    }
+}
+
+bool MidiManager::handleIncomingClockMessage(InputPort& port, const juce::MidiMessage& message, double timeMs)
+{
+    bool isClockMessage = message.isMidiClock() || message.isMidiStart() || message.isMidiContinue()
+                       || message.isMidiStop() || message.isSongPositionPointer();
+    if (!isClockMessage)
+        return false;
+    
+    // One clock at a time - the first source to send one owns the tracker
+    int owner = clockSourceId.load(std::memory_order_acquire);
+    if (owner < 0 && clockSourceId.compare_exchange_strong(owner, port.sourceId))
+    {
+        owner = port.sourceId;
+        
+        // The previous owner was removed while other sources were open - start clean
+        if (clockResetPending.exchange(false))
+            clockTracker.reset();
+    }
+    
+    if (owner != port.sourceId)
+    {
+        port.filteredMessages.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    
+    // Realtime and song position messages stay on the MIDI thread - only the estimate moves on
+    if (message.isMidiClock())
+        clockTracker.handleClock(timeMs);
+    else if (message.isMidiStart())
+        clockTracker.handleStart(timeMs);
+    else if (message.isMidiContinue())
+        clockTracker.handleContinue(timeMs);
+    else if (message.isMidiStop())
+        clockTracker.handleStop(timeMs);
+    else
+        clockTracker.handleSongPosition(message.getSongPositionPointerMidiBeat(), timeMs);
+    
+    return true;
+}
+
+void MidiManager::publishClockState()
+{
+    auto clock = clockTracker.getSnapshot(juce::Time::getMillisecondCounterHiRes());
+    uint32_t updateCount = clockTracker.getUpdateCount();
+    
+    // Report new ticks/transport changes, and the moment the clock goes quiet
+    if (updateCount == lastPublishedClockUpdate && clock.isReceiving == lastPublishedClockReceiving)
+        return;
+    
+    lastPublishedClockUpdate = updateCount;
+    lastPublishedClockReceiving = clock.isReceiving;
+    
+    if (onMidiClockChanged)
+        onMidiClockChanged(clock);
+}
+
+void MidiManager::pushIncomingEvent(InputPort& port, const Midi14BitDecoder::DecodedValue& decoded)
+{
+    IncomingMidiEvent event;
+    event.sourceId = port.sourceId;
+    event.channel = decoded.channel;
+    event.ccNumber = decoded.ccNumber;
+    event.value = decoded.value14bit >> 7;
+    event.value14bit = decoded.value14bit;
+    event.isHighResolution = decoded.isHighResolution;
+    event.timeMs = decoded.timeMs;
+    
+    if (inputQueue.push(event))
+    {
+        receivedInputEvents.fetch_add(1, std::memory_order_relaxed);
+        port.deliveredEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void MidiManager::setHighResolutionInputEnabled(bool shouldDecode)
+{
+    highResolutionInputEnabled = shouldDecode;
+    for (auto& port : inputPorts)
+        port->decoder.reset();
+    CORE_LOG_DEBUG("MidiManager", "14-bit input decoding " << (shouldDecode ? "enabled" : "disabled"));
+}
+
+void MidiManager::dispatchIncomingMidi()
+{
+    // Built once so the per-event monitor callback does not allocate
+    static const juce::String externalSource ("External");
+    
+    double now = juce::Time::getMillisecondCounterHiRes();
+    
+    // Release MSB/LSB halves whose partner never arrived
+    if (highResolutionInputEnabled.load(std::memory_order_relaxed))
+    {
+        for (auto& port : inputPorts)
         {
-            juce::MessageManager::callAsync([this, channel, ccNumber, ccValue]() {
-                onMidiReceived(channel, ccNumber, ccValue);
+            auto& source = *port;
+            source.decoder.flushExpired(now, [this, &source](const Midi14BitDecoder::DecodedValue& decoded) {
+                pushIncomingEvent(source, decoded);
             });
         }
+    }
+    
+    // Drain the frame's events, then merge the sources by timestamp. Each source arrives in
+    // order, so the batch is nearly sorted and an in-place insertion sort is cheap and stable.
+    inputBatch.clear();
+    IncomingMidiEvent event;
+    while ((int)inputBatch.size() < INPUT_QUEUE_SIZE && inputQueue.pop(event))
+        inputBatch.push_back(event);
+    
+    for (size_t i = 1; i < inputBatch.size(); ++i)
+    {
+        if (inputBatch[i - 1].timeMs <= inputBatch[i].timeMs)
+            continue;
         
-        // Notify MIDI monitor about received MIDI
+        auto moved = inputBatch[i];
+        size_t j = i;
+        for (; j > 0 && inputBatch[j - 1].timeMs > moved.timeMs; --j)
+            inputBatch[j] = inputBatch[j - 1];
+        inputBatch[j] = moved;
+    }
+    
+    auto& latencyTracer = LatencyTracer::getInstance();
+    
+    for (const auto& incoming : inputBatch)
+    {
+        // Notify parent component about received MIDI - the handlers run synchronously, so
+        // their dispatch/slider/send stamps attach to this event's trace
+        latencyTracer.beginTrace(incoming.timeMs);
+        if (incoming.isHighResolution && onHighResolutionMidiReceived)
+            onHighResolutionMidiReceived(incoming.channel, incoming.ccNumber, incoming.value14bit);
+        else if (onMidiReceived)
+            onMidiReceived(incoming.channel, incoming.ccNumber, incoming.value);
+        latencyTracer.endTrace();
+        
+        // Notify MIDI monitor about received MIDI, tagged with the source's name
         if (onMidiReceiveForMonitor)
         {
-            juce::MessageManager::callAsync([this, channel, ccNumber, ccValue]() {
-                onMidiReceiveForMonitor(channel, ccNumber, ccValue, "External", -1);
-            });
+            auto* port = findInputPort(incoming.sourceId);
+            onMidiReceiveForMonitor(incoming.channel, incoming.ccNumber, incoming.value,
+                                    port != nullptr ? port->name : externalSource, -1);
         }
     }
-}
\ No newline at end of file
+    
+    largestInputBatch = juce::jmax(largestInputBatch, (int)inputBatch.size());
+    
+    updateInputThroughput(now);
+    publishClockState();
+}
+
+void MidiManager::updateInputThroughput(double nowMs)
+{
+    for (auto& port : inputPorts)
+    {
+        double elapsed = nowMs - port->rateWindowStart;
+        if (elapsed < 1000.0)
+            continue;
+        
+        uint64_t received = port->receivedMessages.load(std::memory_order_relaxed);
+        port->messagesPerSecond = (double)(received - port->rateWindowMessages) * 1000.0 / elapsed;
+        port->rateWindowMessages = received;
+        port->rateWindowStart = nowMs;
+    }
+}
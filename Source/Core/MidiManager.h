@@ -1,13 +1,26 @@
 #pragma once
 #include <JuceHeader.h>
 #include <functional>
+#include <array>
+#include <atomic>
+#include <vector>
+#include <utility>
+#include "MidiOutputQueue.h"
+#include "MidiOutputCoalescer.h"
+#include "MidiOutputSmoother.h"
+#include "MidiBandwidthBudget.h"
+#include "MidiWireEncoder.h"
+#include "MidiUmpOutput.h"
+#include "Midi14BitDecoder.h"
+#include "MidiClockTracker.h"
+#include "MidiEchoSuppressor.h"
 
 //==============================================================================
 /**
  * MidiManager handles all MIDI input/output operations for the Virtual MIDI Controller
  * Extracted from DebugMidiController to provide clean separation of concerns
  */
-class MidiManager : public juce::MidiInputCallback
+class MidiManager
 {
 public:
     MidiManager();
@@ -16,15 +29,115 @@ public:
     // Initialization
     void initializeDevices();
     
-    // Device management
+    // Device management - selectInputDevice swaps the primary (user-selected) input only;
+    // sources added with addInputDevice stay open alongside it
     void selectInputDevice(const juce::String& deviceName);
     bool isOutputConnected() const;
     bool isInputConnected() const;
     juce::String getSelectedDeviceName() const;
+    int getSelectedInputSourceId() const { return selectedInputSourceId; }   // -1 when none is open
     
-    // MIDI communication
+    // MIDI communication (non-blocking - events are queued for the output thread).
+    // shouldSmooth marks coarse values (7-bit input) for the output smoother below.
     void sendCC14Bit(int channel, int ccNumber, int value14bit);
-    void sendCC14BitWithSlider(int sliderNumber, int channel, int ccNumber, int value14bit);
+    void sendCC14BitWithSlider(int sliderNumber, int channel, int ccNumber, int value14bit,
+                               MidiOutputPriority priority = MidiOutputPriority::Manual,
+                               bool shouldSmooth = false);
+    
+    // Senders without access to the settings (the automation output clock) address a slider
+    // by number only - sendSliderValue uses the channel and CC last set with setSliderController
+    // and sends nothing for a slider that has none. Safe from any thread.
+    void setSliderController(int sliderNumber, int channel, int ccNumber);
+    void sendSliderValue(int sliderNumber, int value14bit, MidiOutputPriority priority = MidiOutputPriority::Automation);
+    
+    // Pre-scheduled output - timestamped blocks handed to MidiOutput::sendBlockOfMessages,
+    // thinned per port so a block never takes more than the port's automation share
+    struct ScheduledCCValue {
+        double timeMs = 0.0;    // Absolute juce::Time::getMillisecondCounterHiRes() time
+        int value14bit = 0;
+    };
+    void scheduleCC14BitBlock(int sliderNumber, int channel, int ccNumber, const std::vector<ScheduledCCValue>& values);
+    void cancelScheduledOutput();   // Clears every pending scheduled message on every port
+    
+    // Multiple outputs - each port keeps its own coalescing, pacing, running status and MSB state.
+    // Sliders are routed with a bitmask of port indices (bit 0 = first port); fan-out happens
+    // on the output thread. Adding or removing a port briefly restarts the output thread.
+    int addOutputDevice(const juce::String& deviceIdentifier);   // Returns the port index, or -1
+    int addVirtualOutput(const juce::String& deviceName);        // Returns the port index, or -1
+    int addUmpOutput(std::unique_ptr<MidiUmpOutput> umpOutput);  // Returns the port index, or -1
+    void removeOutputPort(int portIndex);                        // Later ports move down one index
+    int getNumOutputPorts() const { return numOutputPorts.load(); }
+    juce::String getOutputPortName(int portIndex) const;
+    void setSliderOutputRouting(int sliderNumber, uint32_t portMask);
+    uint32_t getSliderOutputRouting(int sliderNumber) const;
+    static constexpr int MAX_OUTPUT_PORTS = 8;
+    static constexpr uint32_t ALL_OUTPUT_PORTS = 0xFFFFFFFF;
+    
+    // Output thread configuration
+    void setOutputThreadPriority(juce::Thread::Priority priority);
+    juce::Thread::Priority getOutputThreadPriority() const { return outputThreadPriority; }
+    uint64_t getDroppedOutputEventCount() const { return outputQueue.getDroppedEventCount(); }
+    
+    // Output coalescing - only the newest value per (channel, CC) is sent each output tick
+    void setOutputCoalescingEnabled(bool shouldCoalesce) { coalescingEnabled = shouldCoalesce; }
+    bool isOutputCoalescingEnabled() const { return coalescingEnabled; }
+    void setOutputTickInterval(int milliseconds) { outputTickMs = juce::jlimit(1, MAX_OUTPUT_TICK_MS, milliseconds); }
+    int getOutputTickInterval() const { return outputTickMs; }
+    int getOutputDrainRateHz() const { return 1000 / outputTickMs.load(); }   // Output ticks per second
+    uint64_t getCoalescedEventCount() const;     // Summed over all ports
+    uint64_t getCoalescedMessageCount() const;   // Data messages only - see getSkippedParameterSelectCount()
+    
+    // Output smoothing - values sent with shouldSmooth glide to their target on the output
+    // thread, which ticks at the smoothing rate while any slider is gliding. The added
+    // latency is bounded by the smoothing time plus one smoothing tick.
+    void setOutputSmoothingEnabled(bool shouldSmooth) { outputSmoothingEnabled = shouldSmooth; }
+    bool isOutputSmoothingEnabled() const { return outputSmoothingEnabled; }
+    void setOutputSmoothingRate(int hz) { outputSmoother.setRate(hz); }
+    int getOutputSmoothingRate() const { return outputSmoother.getRate(); }
+    void setOutputSmoothingTime(double milliseconds) { outputSmoother.setSmoothingTime(milliseconds); }
+    double getOutputSmoothingTime() const { return outputSmoother.getSmoothingTime(); }
+    double getOutputSmoothingLatencyMs() const { return outputSmoother.getAddedLatencyMs(); }
+    
+    // MSB elision - send only the LSB when the MSB for that controller is unchanged.
+    // A full MSB/LSB pair is still re-sent every MSB_REFRESH_INTERVAL_MS per controller.
+    void setMsbElisionEnabled(bool shouldElide);
+    bool isMsbElisionEnabled() const { return msbElisionEnabled; }
+    void invalidateMsbCache();
+    uint64_t getElidedMsbCount() const { return elidedMsbCount.load(); }
+    
+    // Wire bandwidth budget per port - paces output to the port's baud rate (0 = unlimited).
+    // When limited, manual moves are served before automation, automation before bulk.
+    void setWireBaudRate(int portIndex, int baud);
+    int getWireBaudRate(int portIndex) const;
+    float getWireUtilization(int portIndex) const;       // 1.0 = link saturated
+    double getWireBytesPerSecond(int portIndex) const;   // Estimated wire bytes
+    uint64_t getDeferredOutputEventCount(int portIndex) const;
+    uint64_t getWireByteCount(int portIndex) const;
+    
+    // Running status (paced ports whose backend writes our bytes as-is) - pending events are
+    // grouped per channel so repeated status bytes can be dropped (an MSB/LSB pair costs 5
+    // bytes instead of 6). juce::MidiOutput writes every status byte itself, even to a DIN
+    // interface, so none of the ports opened here save anything and none are credited.
+    void setRunningStatusEnabled(bool useRunningStatus);
+    bool isRunningStatusEnabled() const { return runningStatusEnabled; }
+    uint64_t getRunningStatusSavedByteCount() const;
+    
+    // NRPN / RPN output - a slider can address a 14-bit parameter (CC 99/98 or 101/100, then
+    // data entry 6/38) instead of a CC pair. Each port remembers the parameter selected on
+    // every channel, so repeated moves on one slider send only the two data entry messages.
+    void setSliderParameter(int sliderNumber, MidiParameterType type, int parameterNumber);
+    MidiParameterType getSliderParameterType(int sliderNumber) const;
+    int getSliderParameterNumber(int sliderNumber) const;
+    uint64_t getSkippedParameterSelectCount() const { return skippedParameterSelects.load(); }
+    
+    // MIDI 2.0 output - UMP ports that carry MIDI 2.0 get one high-resolution Control Change
+    // packet per update. MIDI 1.0 ports and MidiUmpBytestreamOutput (which ends in a MIDI 1.0
+    // byte stream) always get the 14-bit MSB/LSB pair, so the mode only matters once such
+    // a port is open - see hasMidi2Output().
+    void setUmpOutputEnabled(bool shouldUseMidi2) { umpOutputEnabled = shouldUseMidi2; }
+    bool isUmpOutputEnabled() const { return umpOutputEnabled; }
+    bool hasMidi2Output() const;
+    uint64_t getUmpPacketCount() const { return umpPacketCount.load(); }
     
     // Device preferences
     void saveDevicePreference();
@@ -32,35 +145,284 @@ public:
     
     // Callbacks for parent components
     std::function<void(int channel, int cc, int value)> onMidiReceived;
+    std::function<void(int channel, int msbCC, int value14bit)> onHighResolutionMidiReceived;   // Decoded MSB/LSB pairs
     std::function<void()> onDeviceConnectionChanged;
     std::function<void(const juce::String& deviceName, bool connected)> onConnectionStatusChanged;
     std::function<juce::File()> getPresetDirectory;
     
-    // MIDI Monitor callbacks
-    std::function<void(int sliderNumber, int midiChannel, int ccNumber, int msbValue, int lsbValue, int combinedValue)> onMidiSent;
+    // MIDI Monitor tap - outgoing updates are written to a lock-free ring that the monitor
+    // drains once per UI frame. Nothing is recorded while no monitor is attached.
+    struct OutgoingMonitorEvent
+    {
+        int sliderNumber = 0;
+        int channel = 1;
+        int ccNumber = 0;
+        int value14bit = 0;
+    };
+    void setMonitorAttached(bool isAttached);
+    bool isMonitorAttached() const { return monitorAttached.load(std::memory_order_relaxed); }
+    bool popOutgoingMonitorEvent(OutgoingMonitorEvent& event) { return monitorQueue.pop(event); }   // Message thread only
+    uint64_t getDroppedMonitorEventCount() const { return monitorQueue.getDroppedEventCount(); }
+    
     std::function<void(int midiChannel, int ccNumber, int value, const juce::String& source, int targetSlider)> onMidiReceiveForMonitor;
     
+    // Incoming MIDI - the MIDI callback thread only pushes into a lock-free FIFO; onMidiReceived
+    // and onMidiReceiveForMonitor are then called in one batch per UI frame on the message thread
+    struct IncomingMidiEvent
+    {
+        int sourceId = 0;
+        int channel = 1;
+        int ccNumber = 0;
+        int value = 0;
+        int value14bit = 0;
+        bool isHighResolution = false;  // value14bit came from an MSB/LSB pair
+        double timeMs = 0.0;    // juce::Time::getMillisecondCounterHiRes() time of arrival
+    };
+    uint64_t getReceivedInputEventCount() const { return receivedInputEvents.load(); }
+    uint64_t getDroppedInputEventCount() const { return inputQueue.getDroppedEventCount(); }
+    int getLargestInputBatch() const { return largestInputBatch; }
+    
+    // Multiple inputs - every open input is a source with its own ID, enable flag, channel filter,
+    // 14-bit decoder and counters. Disabled sources and filtered channels are dropped on the MIDI
+    // thread; what passes is merged by timestamp into one batch per input frame.
+    struct InputSourceStatistics
+    {
+        uint64_t receivedMessages = 0;      // Everything the device delivered
+        uint64_t filteredMessages = 0;      // Dropped by the enable flag or channel filter
+        uint64_t deliveredEvents = 0;       // Events queued for the message thread
+        uint64_t suppressedEchoes = 0;      // Our own output that came back through a loopback
+        double messagesPerSecond = 0.0;     // Received, over the last second
+    };
+    int addInputDevice(const juce::String& deviceIdentifier);   // Returns the source ID, or -1
+    void removeInputSource(int sourceId);
+    std::vector<int> getInputSourceIds() const;
+    juce::String getInputSourceName(int sourceId) const;
+    void setInputSourceEnabled(int sourceId, bool shouldReceive);
+    bool isInputSourceEnabled(int sourceId) const;
+    void setInputSourceChannelMask(int sourceId, uint16_t channelMask);   // Bit 0 = channel 1
+    uint16_t getInputSourceChannelMask(int sourceId) const;
+    InputSourceStatistics getInputSourceStatistics(int sourceId) const;
+    static constexpr int MAX_INPUT_SOURCES = 8;
+    static constexpr uint16_t ALL_INPUT_CHANNELS = 0xFFFF;
+    
+    // Echo suppression - every controller message we send is noted per (channel, CC, value);
+    // an incoming message matching one sent within the echo window is dropped on the MIDI
+    // thread as loopback. Everything else on our output channel passes.
+    void setEchoSuppressionEnabled(bool shouldSuppress) { echoSuppressor.setEnabled(shouldSuppress); }
+    bool isEchoSuppressionEnabled() const { return echoSuppressor.isEnabled(); }
+    void setEchoWindowMs(double milliseconds) { echoSuppressor.setWindowMs(milliseconds); }
+    double getEchoWindowMs() const { return echoSuppressor.getWindowMs(); }
+    uint64_t getSuppressedEchoCount() const { return echoSuppressor.getSuppressedEchoCount(); }
+    
+    // 14-bit input - pairs CC 0-31 with CC 32-63 on the MIDI thread and delivers one value per
+    // pair through onHighResolutionMidiReceived (falls back to onMidiReceived with the MSB).
+    // Both send orders pair; the leading half waits at most Midi14BitDecoder::PAIR_TIMEOUT_MS.
+    // Off by default, so every CC is delivered as received; a CC 32-63 with no MSB to pair
+    // with is still delivered as itself when on.
+    void setHighResolutionInputEnabled(bool shouldDecode);
+    bool isHighResolutionInputEnabled() const { return highResolutionInputEnabled.load(); }
+    uint64_t getPairedInputValueCount() const;      // Summed over all sources
+    uint64_t getUnpairedInputValueCount() const;
+    
+    // External MIDI clock - clock, start/stop/continue and song position are tracked on the
+    // MIDI thread; onMidiClockChanged reports the estimate once per input frame while it changes.
+    // The first source to send clock owns it until that source is removed.
+    MidiClockTracker::Snapshot getClockSnapshot() const { return clockTracker.getSnapshot(juce::Time::getMillisecondCounterHiRes()); }
+    std::function<void(const MidiClockTracker::Snapshot& clock)> onMidiClockChanged;
+    
     // Activity indicator support
-    bool getMidiInputActivity() const { return midiInputActivity; }
-    double getLastMidiInputTime() const { return lastMidiInputTime; }
+    bool getMidiInputActivity() const { return midiInputActivity.load(); }
+    double getLastMidiInputTime() const { return lastMidiInputTime.load(); }
     void resetMidiInputActivity() { midiInputActivity = false; }
     
 private:
-    // MidiInputCallback implementation
-    void handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message) override;
+    friend class MidiManagerAllocationTest;
+    
+    // One open input - its own callback object, so the MIDI thread never looks up the port list
+    struct InputPort : public juce::MidiInputCallback
+    {
+        InputPort(MidiManager& owner, int sourceId) : owner(owner), sourceId(sourceId) {}
+        
+        void handleIncomingMidiMessage(juce::MidiInput*, const juce::MidiMessage& message) override
+        {
+            owner.handleIncomingMidiMessage(*this, message);
+        }
+        
+        MidiManager& owner;
+        const int sourceId;
+        juce::String name;
+        Midi14BitDecoder decoder;
+        std::atomic<bool> enabled { true };
+        std::atomic<uint16_t> channelMask { ALL_INPUT_CHANNELS };
+        std::atomic<uint64_t> receivedMessages { 0 };
+        std::atomic<uint64_t> filteredMessages { 0 };
+        std::atomic<uint64_t> deliveredEvents { 0 };
+        std::atomic<uint64_t> suppressedEchoes { 0 };
+        
+        // Throughput window (message thread)
+        double rateWindowStart = 0.0;
+        uint64_t rateWindowMessages = 0;
+        double messagesPerSecond = 0.0;
+        
+        std::unique_ptr<juce::MidiInput> device;    // Declared last so it is destroyed first
+    };
+    
+    // Runs on each input's MIDI thread
+    void handleIncomingMidiMessage(InputPort& port, const juce::MidiMessage& message);
+    
+    InputPort* findInputPort(int sourceId) const;
     
     // Internal device management
     void initializeOutput();
     void initializeInput();
     
+    // Frame clock for incoming MIDI - runs only while an input device is open
+    class InputDispatchTimer : public juce::Timer
+    {
+    public:
+        explicit InputDispatchTimer(MidiManager& owner) : owner(owner) {}
+        void timerCallback() override { owner.dispatchIncomingMidi(); }
+        
+    private:
+        MidiManager& owner;
+    };
+    
+    void dispatchIncomingMidi();    // Message thread only
+    void pushIncomingEvent(InputPort& port, const Midi14BitDecoder::DecodedValue& decoded);
+    bool handleIncomingClockMessage(InputPort& port, const juce::MidiMessage& message, double timeMs);
+    void updateInputThroughput(double nowMs);
+    void publishClockState();       // Message thread only
+    
+    // Dedicated output thread - drains outputQueue so GUI hitches never reach the MIDI port.
+    // It ticks while anything is pending and sleeps until the next push when idle.
+    class OutputThread : public juce::Thread
+    {
+    public:
+        explicit OutputThread(MidiManager& owner);
+        void run() override;
+        
+    private:
+        MidiManager& owner;
+    };
+    
+    void startOutputThread();
+    void stopOutputThread();
+    
+    // MSB elision state per (channel, CC) - lastSentMsb of -1 forces a full pair
+    struct MsbState
+    {
+        std::atomic<int> lastSentMsb { -1 };
+        double lastFullPairTime = 0.0;
+    };
+    
+    // Parameter selected on one channel of a receiver, as (type << 14) | number (-1 = unknown).
+    // Until externalUntil, scheduled blocks may re-select underneath the output thread.
+    struct ParameterSelectState
+    {
+        int selected = -1;
+        std::atomic<double> externalUntil { 0.0 };
+    };
+    
+    // One open output device and everything that depends on what its receiver has seen.
+    // Exactly one of device (MIDI 1.0 byte stream) or umpDevice (UMP endpoint) is set.
+    struct OutputPort
+    {
+        std::unique_ptr<juce::MidiOutput> device;
+        std::unique_ptr<MidiUmpOutput> umpDevice;
+        bool writesRawBytes = false;    // False for juce::MidiOutput, which re-adds every status byte
+        MidiOutputCoalescer coalescer;
+        MidiBandwidthBudget budget;
+        MidiWireEncoder encoder;
+        std::array<MsbState, 16 * 128> msbStates;
+        std::array<ParameterSelectState, 16> parameterStates;
+    };
+    
+    int addOutputPort(std::unique_ptr<OutputPort> port);
+    void updateRunningStatus(OutputPort& port);
+    OutputPort* getOutputPort(int portIndex) const;
+    uint32_t getRoutingMask(int sliderNumber) const;
+    void drainOutputQueue();                                                    // Output thread only
+    void routeOutputEvent(const MidiOutputEvent& event, bool shouldCoalesce);   // Output thread only
+    void advanceSmoothedOutput();                                               // Output thread only
+    void flushCoalescedOutput();                                                // Output thread only
+    bool hasPendingOutput() const;                                              // Output thread only
+    void pushOutputEvent(const MidiOutputEvent& event);                         // Any thread
+    bool sendEventNow(OutputPort& port, const MidiOutputEvent& event, bool notifyMonitor);   // Output thread only - false if deferred by the budget
+    bool sendUmpEventNow(OutputPort& port, const MidiOutputEvent& event, bool notifyMonitor); // Output thread only
+    bool canElideMsb(OutputPort& port, int channel, int ccNumber, int msb, double now);     // Output thread only
+    bool sendParameterEventNow(OutputPort& port, const MidiOutputEvent& event, bool notifyMonitor);  // Output thread only
+    int sendController7Now(OutputPort& port, int channel, int ccNumber, int value7bit);             // Output thread only - returns bytes sent
+    int sendUmpController(MidiUmpOutput& umpOutput, int channel, int ccNumber, int value14bit, double timeMs);   // Returns bytes sent
+    int sendUmpController7(MidiUmpOutput& umpOutput, int channel, int ccNumber, int value7bit, double timeMs);   // Returns bytes sent
+    bool sendsMidi2Packets(const MidiUmpOutput& umpOutput) const;
+    int getSliderParameterKey(int sliderNumber) const;
+    
+    // Fills (CC, value) messages for a parameter update - select (if asked) then data entry
+    using ControllerMessages = std::array<std::pair<int, int>, 4>;
+    static int getParameterMessages(MidiParameterType type, int parameterNumber, int value14bit,
+                                    bool includeSelect, ControllerMessages& messages);
+    void notifyMidiSent(int sliderNumber, int channel, int ccNumber, int value14bit);
+    
     // Member variables
-    std::unique_ptr<juce::MidiOutput> midiOutput;
-    std::unique_ptr<juce::MidiInput> midiInput;
+    std::vector<std::unique_ptr<OutputPort>> outputPorts;   // Only resized while the output thread is stopped
+    std::atomic<int> numOutputPorts { 0 };
+    std::array<std::atomic<uint32_t>, 32> sliderRouting;    // Indexed by slider number (0 = no slider)
+    std::array<std::atomic<int>, 32> sliderParameters;      // (type << 14) | number, 0 = plain CC
+    std::array<std::atomic<int>, 32> sliderControllers;     // ((channel - 1) << 7) | CC, -1 = not set
+    std::atomic<uint64_t> skippedParameterSelects { 0 };
+    
+    // Monitor tap
+    LockFreeQueue<OutgoingMonitorEvent, 1024> monitorQueue;
+    std::atomic<bool> monitorAttached { false };
+    MidiOutputQueue outputQueue;
+    std::unique_ptr<OutputThread> outputThread;
+    std::atomic<bool> outputThreadIdle { false };  // Set while the thread sleeps until woken
+    juce::Thread::Priority outputThreadPriority = juce::Thread::Priority::high;
+    std::atomic<bool> coalescingEnabled { true };
+    MidiOutputSmoother outputSmoother;
+    std::atomic<bool> outputSmoothingEnabled { true };
+    std::atomic<int> outputTickMs { DEFAULT_OUTPUT_TICK_MS };
+    std::atomic<bool> runningStatusEnabled { true };
+    std::atomic<bool> umpOutputEnabled { false };
+    std::atomic<uint64_t> umpPacketCount { 0 };
+    static constexpr int DEFAULT_OUTPUT_TICK_MS = 2;
+    static constexpr int MAX_OUTPUT_TICK_MS = 50;
+    
+    // MSB elision
+    std::atomic<bool> msbElisionEnabled { false };
+    std::atomic<uint64_t> elidedMsbCount { 0 };
+    static constexpr double MSB_REFRESH_INTERVAL_MS = 1000.0;
+    
+    // Scheduled block resolution: 10 samples per millisecond
+    static constexpr double SCHEDULE_SAMPLES_PER_SECOND = 10000.0;
+    
+    // Input sources - the list itself is only touched on the message thread
+    std::vector<std::unique_ptr<InputPort>> inputPorts;
+    int nextInputSourceId = 0;
+    int selectedInputSourceId = -1;
     juce::String selectedMidiDeviceName;
     
+    // Incoming event FIFO, and the batch it is drained into for timestamp ordering
+    static constexpr int INPUT_QUEUE_SIZE = 2048;
+    LockFreeQueue<IncomingMidiEvent, INPUT_QUEUE_SIZE> inputQueue;
+    std::vector<IncomingMidiEvent> inputBatch;
+    std::atomic<uint64_t> receivedInputEvents { 0 };
+    int largestInputBatch = 0;
+    std::atomic<bool> highResolutionInputEnabled { false };
+    MidiEchoSuppressor echoSuppressor;
+    
+    // External clock (written on the owning source's MIDI thread, published per frame)
+    MidiClockTracker clockTracker;
+    std::atomic<int> clockSourceId { -1 };
+    std::atomic<bool> clockResetPending { false };    // Reset by the next owner's MIDI thread
+    uint32_t lastPublishedClockUpdate = 0;
+    bool lastPublishedClockReceiving = false;
+    std::unique_ptr<InputDispatchTimer> inputDispatchTimer;
+    static constexpr int INPUT_DISPATCH_INTERVAL_MS = 16;  // ~60fps
+    
     // Activity tracking
-    bool midiInputActivity = false;
-    double lastMidiInputTime = 0.0;
+    std::atomic<bool> midiInputActivity { false };
+    std::atomic<double> lastMidiInputTime { 0.0 };
     static constexpr double MIDI_INPUT_ACTIVITY_DURATION = 150.0; // milliseconds
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiManager)
@@ -0,0 +1,124 @@
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "MidiOutputQueue.h"
+
+//==============================================================================
+/**
+ * MidiOutputCoalescer keeps one pending slot per (channel, CC) on the output thread.
+ * A newer value overwrites the pending one, and flush() emits only the dirty slots,
+ * so a burst collapses to at most one MSB/LSB pair per controller per output tick.
+ * NRPN/RPN events get one slot per (channel, slider), since each slider has one target.
+ * A superseded NRPN/RPN value counts as its two data entry messages only. The surviving
+ * value selects the same parameter, so the select is normally sent either way - selects
+ * that are skipped are counted separately by MidiManager::getSkippedParameterSelectCount().
+ * Not thread-safe except for the statistics getters - owned by the output thread.
+ */
+class MidiOutputCoalescer
+{
+public:
+    MidiOutputCoalescer() = default;
+
+    // Store an event, replacing any value still pending for the same controller
+    void add(const MidiOutputEvent& event) noexcept
+    {
+        int slotIndex = getSlotIndex(event);
+        auto& slot = slots[(size_t)slotIndex];
+
+        if (slot.isDirty)
+        {
+            // The pending value never reached the wire - count what was saved
+            coalescedEvents.fetch_add(1, std::memory_order_relaxed);
+            coalescedMessages.fetch_add(event.isParameterEvent() || event.getCCNumber() < 96 ? 2 : 1, std::memory_order_relaxed);
+        }
+        else
+        {
+            slot.isDirty = true;
+            dirtySlots[(size_t)numDirtySlots++] = (uint16_t)slotIndex;
+        }
+
+        slot.event = event;
+    }
+
+    // Offer every dirty slot to send() in first-touched order. Slots it accepts (returns true)
+    // are cleared; refused slots stay pending, keeping their order, for a later flush
+    template <typename SendFunction>
+    void flush(SendFunction&& send)
+    {
+        int numKept = 0;
+
+        for (int i = 0; i < numDirtySlots; ++i)
+        {
+            uint16_t slotIndex = dirtySlots[(size_t)i];
+            auto& slot = slots[slotIndex];
+
+            if (send(slot.event))
+                slot.isDirty = false;
+            else
+                dirtySlots[(size_t)numKept++] = slotIndex;
+        }
+
+        numDirtySlots = numKept;
+    }
+
+    // Order pending slots by (channel, kind, number) so each channel's messages - CCs, then
+    // parameters - go out back to back and the wire encoder can use running status across them
+    void sortPendingByChannel() noexcept
+    {
+        std::sort(dirtySlots.begin(), dirtySlots.begin() + numDirtySlots,
+                  [](uint16_t a, uint16_t b) { return getChannelOrderKey(a) < getChannelOrderKey(b); });
+    }
+
+    bool hasPendingEvents() const noexcept { return numDirtySlots > 0; }
+
+    // Statistics (readable from any thread)
+    uint64_t getCoalescedEventCount() const noexcept   { return coalescedEvents.load(std::memory_order_relaxed); }
+    uint64_t getCoalescedMessageCount() const noexcept { return coalescedMessages.load(std::memory_order_relaxed); }
+    void resetStatistics() noexcept
+    {
+        coalescedEvents.store(0, std::memory_order_relaxed);
+        coalescedMessages.store(0, std::memory_order_relaxed);
+    }
+
+    static constexpr int NUM_CC_SLOTS = 16 * 128;
+    static constexpr int NUM_SLOTS = NUM_CC_SLOTS + 16 * 32;
+
+private:
+    static int getSlotIndex(const MidiOutputEvent& event) noexcept
+    {
+        if (event.isParameterEvent())
+            return NUM_CC_SLOTS + (event.getChannel() - 1) * 32 + event.getSliderNumber();
+
+        return (event.getChannel() - 1) * 128 + event.getCCNumber();
+    }
+
+    // CC slots are laid out per channel, parameter slots after all of them - key both by channel first
+    static int getChannelOrderKey(int slotIndex) noexcept
+    {
+        if (slotIndex >= NUM_CC_SLOTS)
+        {
+            int parameterSlot = slotIndex - NUM_CC_SLOTS;
+            return (parameterSlot / 32) * 256 + 128 + parameterSlot % 32;
+        }
+
+        return (slotIndex / 128) * 256 + slotIndex % 128;
+    }
+
+    struct Slot
+    {
+        MidiOutputEvent event;
+        bool isDirty = false;
+    };
+
+    std::array<Slot, NUM_SLOTS> slots;
+    std::array<uint16_t, NUM_SLOTS> dirtySlots {};
+    int numDirtySlots = 0;
+
+    std::atomic<uint64_t> coalescedEvents { 0 };
+    std::atomic<uint64_t> coalescedMessages { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiOutputCoalescer)
+};
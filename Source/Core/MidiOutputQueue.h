@@ -0,0 +1,87 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cstdint>
+#include "LockFreeQueue.h"
+
+//==============================================================================
+/**
+ * Priority classes for outgoing controller updates - the bandwidth pacer serves
+ * manual moves first, then automation, then bulk recalls
+ */
+enum class MidiOutputPriority
+{
+    Manual = 0,
+    Automation = 1,
+    Bulk = 2
+};
+
+//==============================================================================
+/**
+ * How a 14-bit value is addressed on the wire - a CC MSB/LSB pair, or parameter
+ * number select (NRPN 99/98, RPN 101/100) followed by data entry (6/38)
+ */
+enum class MidiParameterType
+{
+    ControlChange = 0,
+    Nrpn = 1,
+    Rpn = 2
+};
+
+//==============================================================================
+/**
+ * MidiOutputEvent is one outgoing 14-bit controller update packed into 64 bits
+ * so it can travel through MidiOutputQueue without any allocation
+ *
+ * Layout: bits 0-13 value, 14-20 CC number, 21-24 channel (0-15), 25-29 slider number (0 = none),
+ *         30-31 priority class, 32-33 parameter type, 34-47 NRPN/RPN parameter number,
+ *         48 smoothing requested
+ */
+struct MidiOutputEvent
+{
+    uint64_t packed = 0;
+
+    static MidiOutputEvent make(int sliderNumber, int channel, int ccNumber, int value14bit,
+                                MidiOutputPriority priority = MidiOutputPriority::Manual) noexcept
+    {
+        MidiOutputEvent event;
+        event.packed = (uint64_t)(juce::jlimit(0, 16383, value14bit))
+                     | ((uint64_t)(ccNumber & 0x7F) << 14)
+                     | ((uint64_t)((juce::jlimit(1, 16, channel) - 1) & 0x0F) << 21)
+                     | ((uint64_t)(juce::jlimit(0, 31, sliderNumber)) << 25)
+                     | ((uint64_t)priority << 30);
+        return event;
+    }
+
+    static MidiOutputEvent makeParameter(int sliderNumber, int channel, MidiParameterType type, int parameterNumber,
+                                         int value14bit, MidiOutputPriority priority = MidiOutputPriority::Manual) noexcept
+    {
+        auto event = make(sliderNumber, channel, 0, value14bit, priority);
+        event.packed |= ((uint64_t)type << 32)
+                      | ((uint64_t)(juce::jlimit(0, 16383, parameterNumber)) << 34);
+        return event;
+    }
+
+    // Coarse input - the output thread glides to this value instead of jumping (MidiOutputSmoother)
+    MidiOutputEvent withSmoothing() const noexcept
+    {
+        MidiOutputEvent event = *this;
+        event.packed |= SMOOTHING_BIT;
+        return event;
+    }
+
+    static constexpr uint64_t SMOOTHING_BIT = (uint64_t)1 << 48;
+
+    int getValue14Bit() const noexcept  { return (int)(packed & 0x3FFF); }
+    int getCCNumber() const noexcept    { return (int)((packed >> 14) & 0x7F); }
+    int getChannel() const noexcept     { return (int)((packed >> 21) & 0x0F) + 1; }
+    int getSliderNumber() const noexcept { return (int)((packed >> 25) & 0x1F); }
+    MidiOutputPriority getPriority() const noexcept { return (MidiOutputPriority)((packed >> 30) & 0x03); }
+    MidiParameterType getParameterType() const noexcept { return (MidiParameterType)((packed >> 32) & 0x03); }
+    int getParameterNumber() const noexcept { return (int)((packed >> 34) & 0x3FFF); }
+    bool isParameterEvent() const noexcept { return getParameterType() != MidiParameterType::ControlChange; }
+    bool isSmoothingRequested() const noexcept { return (packed & SMOOTHING_BIT) != 0; }
+};
+
+//==============================================================================
+// Carries MidiOutputEvents from any producer thread to the single MIDI output thread
+using MidiOutputQueue = LockFreeQueue<MidiOutputEvent, 1024>;
@@ -0,0 +1,190 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include "MidiOutputQueue.h"
+
+//==============================================================================
+/**
+ * MidiOutputSmoother turns sparse, coarse slider updates (7-bit input arrives in 129-unit
+ * steps at controller rate) into a continuous 14-bit stream. Each slider follows its latest
+ * target with a critically damped spring, advanced on the output thread at the smoothing
+ * rate, so steps become S-curves without overshoot and the stream only carries a value
+ * when the rounded output actually moves.
+ *
+ * The added latency is bounded: a steady ramp is followed with a lag of exactly the
+ * smoothing time, and a step is 90% complete after ~1.9x the smoothing time. Updates
+ * without the smoothing flag (automation, 14-bit input) cancel the slider's motion and
+ * become its new resting value, so the smoother never fights another source.
+ *
+ * Not thread-safe except for the configuration setters/getters - owned by the output thread.
+ */
+class MidiOutputSmoother
+{
+public:
+    MidiOutputSmoother() = default;
+
+    // Configuration (any thread)
+    void setRate(int hz) { rateHz.store(juce::jlimit(MIN_RATE_HZ, MAX_RATE_HZ, hz), std::memory_order_relaxed); }
+    int getRate() const { return rateHz.load(std::memory_order_relaxed); }
+    int getTickIntervalMs() const { return juce::jmax(1, juce::roundToInt(1000.0 / getRate())); }
+    void setSmoothingTime(double ms) { smoothingTimeMs.store(juce::jlimit(MIN_SMOOTHING_MS, MAX_SMOOTHING_MS, ms), std::memory_order_relaxed); }
+    double getSmoothingTime() const { return smoothingTimeMs.load(std::memory_order_relaxed); }
+
+    // Worst-case delay added to a moving value: the ramp lag plus one output tick
+    double getAddedLatencyMs() const { return getSmoothingTime() + getTickIntervalMs(); }
+
+    // A new target for the event's slider. The first value a slider sees goes straight out.
+    template <typename EmitFunction>
+    void setTarget(const MidiOutputEvent& event, double nowMs, EmitFunction&& emit)
+    {
+        auto* slot = getSlot(event);
+        if (slot == nullptr)
+        {
+            emit(event);
+            return;
+        }
+
+        slot->target = event.getValue14Bit();
+
+        if (!slot->hasValue || !isSameController(slot->event, event))
+        {
+            // Nothing to glide from - emit the value as it is
+            setResting(event);
+            emit(event);
+            return;
+        }
+
+        slot->event = event;
+        if (!slot->isMoving)
+        {
+            slot->isMoving = true;
+            slot->lastAdvanceTime = nowMs;
+            ++numMoving;
+        }
+    }
+
+    // An unsmoothed update took over the slider - stop gliding and rest at its value
+    void setResting(const MidiOutputEvent& event) noexcept
+    {
+        auto* slot = getSlot(event);
+        if (slot == nullptr)
+            return;
+
+        stopMoving(*slot);
+        slot->event = event;
+        slot->position = slot->target = slot->lastEmitted = event.getValue14Bit();
+        slot->velocity = 0.0;
+        slot->hasValue = true;
+    }
+
+    // Move every gliding slider up to nowMs, emitting those whose rounded value changed
+    template <typename EmitFunction>
+    void advance(double nowMs, EmitFunction&& emit)
+    {
+        if (numMoving == 0)
+            return;
+
+        double omega = 2.0 / getSmoothingTime();    // Ramp lag of a critically damped spring is 2 / omega
+
+        for (auto& slot : slots)
+        {
+            if (!slot.isMoving)
+                continue;
+
+            double dt = juce::jmax(0.0, nowMs - slot.lastAdvanceTime);
+            slot.lastAdvanceTime = nowMs;
+
+            // Exact solution for a constant target over dt, so a late tick cannot go unstable
+            double offset = slot.position - slot.target;
+            double decay = std::exp(-omega * dt);
+            double term = slot.velocity + omega * offset;
+            slot.position = slot.target + (offset + term * dt) * decay;
+            slot.velocity = (slot.velocity - omega * term * dt) * decay;
+
+            if (std::abs(slot.position - slot.target) < SETTLE_DISTANCE && std::abs(slot.velocity) < SETTLE_VELOCITY)
+            {
+                slot.position = slot.target;
+                slot.velocity = 0.0;
+                stopMoving(slot);
+            }
+
+            int value = juce::jlimit(0, 16383, juce::roundToInt(slot.position));
+            if (value != slot.lastEmitted)
+            {
+                slot.lastEmitted = value;
+                emit(withValue(slot.event, value));
+            }
+        }
+    }
+
+    bool isMoving() const noexcept { return numMoving > 0; }
+
+    // Forget every slider (e.g. when the output ports change)
+    void reset() noexcept
+    {
+        slots.fill({});
+        numMoving = 0;
+    }
+
+    static constexpr int MIN_RATE_HZ = 100;
+    static constexpr int MAX_RATE_HZ = 1000;
+    static constexpr int DEFAULT_RATE_HZ = 500;
+    static constexpr double MIN_SMOOTHING_MS = 1.0;
+    static constexpr double MAX_SMOOTHING_MS = 50.0;
+    static constexpr double DEFAULT_SMOOTHING_MS = 8.0;
+
+private:
+    struct Slot
+    {
+        MidiOutputEvent event;          // Latest event - addressing and priority for emitted values
+        double target = 0.0;
+        double position = 0.0;
+        double velocity = 0.0;          // Units per millisecond
+        double lastAdvanceTime = 0.0;
+        int lastEmitted = 0;
+        bool hasValue = false;
+        bool isMoving = false;
+    };
+
+    Slot* getSlot(const MidiOutputEvent& event) noexcept
+    {
+        int sliderNumber = event.getSliderNumber();
+        return sliderNumber > 0 ? &slots[(size_t)sliderNumber] : nullptr;
+    }
+
+    static bool isSameController(const MidiOutputEvent& a, const MidiOutputEvent& b) noexcept
+    {
+        // Everything but value, priority and the smoothing flag
+        constexpr uint64_t addressMask = ~((uint64_t)0x3FFF | ((uint64_t)0x03 << 30) | MidiOutputEvent::SMOOTHING_BIT);
+        return (a.packed & addressMask) == (b.packed & addressMask);
+    }
+
+    static MidiOutputEvent withValue(const MidiOutputEvent& event, int value14bit) noexcept
+    {
+        MidiOutputEvent updated = event;
+        updated.packed = (event.packed & ~(uint64_t)0x3FFF) | (uint64_t)value14bit;
+        return updated;
+    }
+
+    void stopMoving(Slot& slot) noexcept
+    {
+        if (slot.isMoving)
+        {
+            slot.isMoving = false;
+            --numMoving;
+        }
+    }
+
+    static constexpr double SETTLE_DISTANCE = 0.5;      // Under half a step - rounds to the target
+    static constexpr double SETTLE_VELOCITY = 0.01;     // Units per millisecond
+
+    std::array<Slot, 32> slots;     // Indexed by slider number (0 = no slider, never smoothed)
+    int numMoving = 0;
+
+    std::atomic<int> rateHz { DEFAULT_RATE_HZ };
+    std::atomic<double> smoothingTimeMs { DEFAULT_SMOOTHING_MS };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiOutputSmoother)
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cstdint>
+
+//==============================================================================
+/**
+ * MidiUmpOutput is an output destination that takes Universal MIDI Packets directly.
+ * juce::MidiOutput only carries MIDI 1.0 byte streams, so MIDI 2.0 transports (network
+ * MIDI 2.0, platform UMP endpoints, plugin hosts) are added to MidiManager through this
+ * interface with MidiManager::addUmpOutput().
+ */
+class MidiUmpOutput
+{
+public:
+    virtual ~MidiUmpOutput() = default;
+    
+    virtual juce::String getName() const = 0;
+    
+    // Deliver one packet. timeMs is a juce::Time::getMillisecondCounterHiRes() time;
+    // anything at or before now is sent immediately. Called from the output thread
+    // and, for pre-scheduled automation, from the message thread.
+    virtual void sendPacket(const uint32_t* words, int numWords, double timeMs) = 0;
+    
+    // Drop packets queued for the future (scheduled automation was cancelled)
+    virtual void clearPendingPackets() {}
+    
+    // False for endpoints that end in a MIDI 1.0 byte stream - MidiManager sends them
+    // MIDI 1.0-protocol packets even in MIDI 2.0 mode, since the wire can't carry more
+    virtual bool carriesMidi2Protocol() const { return true; }
+};
+
+//==============================================================================
+/**
+ * MidiUmpEncoder builds the controller packets MidiManager sends to MidiUmpOutputs.
+ * A MIDI 2.0 Control Change carries 32 bits of resolution in one 64-bit packet, so a
+ * 14-bit slider update is one packet instead of an MSB/LSB pair the receiver has to re-pair.
+ */
+struct MidiUmpEncoder
+{
+    static juce::universal_midi_packets::PacketX2 makeControlChange(int channel, int ccNumber, int value14bit)
+    {
+        namespace ump = juce::universal_midi_packets;
+        
+        // Standard MIDI 2.0 upscaling keeps the 14-bit value in the top bits, so
+        // downconverting receivers recover it exactly
+        return ump::Factory::makeControlChangeV2(0, (uint8_t)((channel - 1) & 0x0F), (uint8_t)(ccNumber & 0x7F),
+                                                 ump::Conversion::scaleTo32((uint16_t)juce::jlimit(0, 16383, value14bit)));
+    }
+    
+    // MIDI 1.0 protocol packet for UMP endpoints when the MIDI 2.0 mode is off
+    static juce::universal_midi_packets::PacketX1 makeMidi1ControlChange(int channel, int ccNumber, int value7bit)
+    {
+        return juce::universal_midi_packets::Factory::makeControlChangeV1(0, (uint8_t)((channel - 1) & 0x0F),
+                                                                           (uint8_t)(ccNumber & 0x7F), (uint8_t)(value7bit & 0x7F));
+    }
+    
+    static constexpr int CONTROL_CHANGE_V2_BYTES = 8;
+    static constexpr int CONTROL_CHANGE_V1_BYTES = 4;
+};
+
+//==============================================================================
+/**
+ * MidiUmpBytestreamOutput delivers MIDI 1.0-protocol packets to any MIDI device through
+ * juce::MidiOutput, one message per packet. It can't carry MIDI 2.0, so it reports
+ * carriesMidi2Protocol() false and MidiManager keeps it on MSB/LSB pairs; other packet
+ * types are dropped. Packets that are due go straight out with sendMessageNow(), so the
+ * output thread doesn't allocate. Future packets (pre-scheduled automation, message
+ * thread only) go through one reused MidiBuffer.
+ */
+class MidiUmpBytestreamOutput : public MidiUmpOutput
+{
+public:
+    explicit MidiUmpBytestreamOutput(std::unique_ptr<juce::MidiOutput> deviceToUse)
+        : device(std::move(deviceToUse))
+    {
+        scheduledMessage.ensureSize(16);
+        device->startBackgroundThread();
+    }
+    
+    ~MidiUmpBytestreamOutput() override
+    {
+        device->stopBackgroundThread();
+    }
+    
+    // Returns nullptr when the device can't be opened
+    static std::unique_ptr<MidiUmpOutput> open(const juce::String& deviceIdentifier)
+    {
+        if (auto device = juce::MidiOutput::openDevice(deviceIdentifier))
+            return std::make_unique<MidiUmpBytestreamOutput>(std::move(device));
+        return nullptr;
+    }
+    
+    juce::String getName() const override { return device->getName() + " (UMP)"; }
+    
+    void sendPacket(const uint32_t* words, int numWords, double timeMs) override
+    {
+        // Only MIDI 1.0 channel voice - the packet carries the message bytes as they are
+        if (numWords < 1 || (words[0] >> 28) != 0x2)
+            return;
+        
+        uint32_t header = words[0];
+        juce::MidiMessage message((int)(header >> 16) & 0xFF, (int)(header >> 8) & 0x7F, (int)header & 0x7F);
+        
+        if (timeMs <= juce::Time::getMillisecondCounterHiRes())
+        {
+            device->sendMessageNow(message);
+            return;
+        }
+        
+        scheduledMessage.clear();
+        scheduledMessage.addEvent(message, 0);
+        device->sendBlockOfMessages(scheduledMessage, timeMs, 1000.0);
+    }
+    
+    void clearPendingPackets() override { device->clearAllPendingMessages(); }
+    
+    bool carriesMidi2Protocol() const override { return false; }
+    
+private:
+    std::unique_ptr<juce::MidiOutput> device;
+    juce::MidiBuffer scheduledMessage;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiUmpBytestreamOutput)
+};
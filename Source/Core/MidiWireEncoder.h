@@ -0,0 +1,107 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+/**
+ * MidiWireEncoder estimates the byte stream a MIDI 1.0 port carries. With running
+ * status a channel message whose status byte repeats the previous one costs 2 bytes
+ * instead of 3, so an MSB/LSB pair on one channel costs 5 bytes instead of 6.
+ * MidiManager groups pending events per channel and runs every outgoing message through
+ * encode(), which returns its estimated size on the wire for the bandwidth budget.
+ * The saving is only real when the backend writes the bytes as sized here. juce::MidiOutput
+ * sends every message with its status byte, so running status is off by default and
+ * MidiManager only enables it for a paced port whose backend writes raw bytes.
+ * Owned by the output thread except for configuration, invalidation and statistics.
+ */
+class MidiWireEncoder
+{
+public:
+    MidiWireEncoder() = default;
+    
+    // Configuration (any thread)
+    void setRunningStatusEnabled(bool enabled) { runningStatusEnabled = enabled; invalidateRunningStatus(); }
+    bool isRunningStatusEnabled() const { return runningStatusEnabled.load(); }
+    
+    // Another writer touched the port (scheduled block, reconnect) - the next message needs its status byte
+    void invalidateRunningStatus() { statusInvalidated.store(true, std::memory_order_release); }
+    
+    // Output thread only
+    int getMessageSize(const juce::MidiMessage& message) const
+    {
+        int size = message.getRawDataSize();
+        return canUseRunningStatus(message) ? size - 1 : size;
+    }
+    
+    // Wire size of two messages sent back to back (e.g. an MSB/LSB pair)
+    int getPairSize(const juce::MidiMessage& first, const juce::MidiMessage& second) const
+    {
+        int secondSize = second.getRawDataSize();
+        if (runningStatusEnabled.load(std::memory_order_relaxed)
+            && second.getRawData()[0] < 0xF0
+            && second.getRawData()[0] == first.getRawData()[0])
+            --secondSize;
+        
+        return getMessageSize(first) + secondSize;
+    }
+    
+    // Encode one outgoing message - returns the bytes it occupies on the wire
+    int encode(const juce::MidiMessage& message)
+    {
+        if (statusInvalidated.exchange(false, std::memory_order_acquire))
+            lastStatusByte = -1;
+        
+        int size = message.getRawDataSize();
+        int statusByte = message.getRawData()[0];
+        
+        if (canUseRunningStatus(message))
+        {
+            --size;
+            savedBytes.fetch_add(1, std::memory_order_relaxed);
+        }
+        
+        // Channel messages set running status, system common messages cancel it,
+        // real-time messages leave it untouched
+        if (statusByte < 0xF0)
+            lastStatusByte = statusByte;
+        else if (statusByte < 0xF8)
+            lastStatusByte = -1;
+        
+        encodedBytes.fetch_add((uint64_t)size, std::memory_order_relaxed);
+        return size;
+    }
+    
+    // Wire size of a block of consecutive messages sharing one status byte
+    int getRunSize(int numMessages, int messageSize) const
+    {
+        if (numMessages <= 0)
+            return 0;
+        
+        return runningStatusEnabled.load() ? messageSize + (numMessages - 1) * (messageSize - 1)
+                                           : numMessages * messageSize;
+    }
+    
+    // Statistics (any thread)
+    uint64_t getEncodedByteCount() const { return encodedBytes.load(std::memory_order_relaxed); }
+    uint64_t getRunningStatusSavedByteCount() const { return savedBytes.load(std::memory_order_relaxed); }
+    
+private:
+    bool canUseRunningStatus(const juce::MidiMessage& message) const
+    {
+        int statusByte = message.getRawData()[0];
+        return runningStatusEnabled.load(std::memory_order_relaxed)
+            && statusByte < 0xF0
+            && statusByte == lastStatusByte
+            && !statusInvalidated.load(std::memory_order_relaxed);
+    }
+    
+    std::atomic<bool> runningStatusEnabled { false };
+    std::atomic<bool> statusInvalidated { false };
+    int lastStatusByte = -1;
+    
+    std::atomic<uint64_t> encodedBytes { 0 };
+    std::atomic<uint64_t> savedBytes { 0 };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiWireEncoder)
+};
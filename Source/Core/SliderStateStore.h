@@ -0,0 +1,113 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+/**
+ * SliderStateStore holds the current 14-bit value, lock flag and automation flag of every
+ * slider, readable and writable from any thread without locks. Each slider's state is one
+ * atomic word (value, flags and a 16-bit change version), so a reader always gets a value
+ * and flags that belong together, and writers merge their change with a CAS loop.
+ *
+ * SimpleSliderControl publishes every change of its juce::Slider here, so the MIDI,
+ * automation and keyboard engines read slider state directly instead of calling back into
+ * the GUI. The sliders are the only writers, so the store never holds state the GUI
+ * doesn't already show.
+ */
+class SliderStateStore
+{
+public:
+    static constexpr int NUM_SLIDERS = 16;
+
+    struct SliderState
+    {
+        int value14bit = 0;
+        bool isLocked = false;
+        bool isAutomating = false;
+        uint16_t version = 0;       // Bumped on every change to this slider, wraps
+    };
+
+    SliderStateStore()
+    {
+        for (auto& word : states)
+            word.store(0, std::memory_order_relaxed);
+    }
+
+    // Readers (any thread)
+    SliderState getState(int sliderIndex) const noexcept
+    {
+        if (!juce::isPositiveAndBelow(sliderIndex, NUM_SLIDERS))
+            return {};
+
+        return unpack(states[(size_t)sliderIndex].load(std::memory_order_acquire));
+    }
+
+    int getValue(int sliderIndex) const noexcept        { return getState(sliderIndex).value14bit; }
+    bool isLocked(int sliderIndex) const noexcept       { return getState(sliderIndex).isLocked; }
+    bool isAutomating(int sliderIndex) const noexcept   { return getState(sliderIndex).isAutomating; }
+
+    // Bumped after any change to any slider - compare with the last value seen to skip idle frames
+    uint32_t getVersion() const noexcept { return version.load(std::memory_order_acquire); }
+
+    // Writers (any thread) - a write that changes nothing does not bump the versions
+    void setValue(int sliderIndex, int value14bit) noexcept
+    {
+        update(sliderIndex, VALUE_MASK, (uint32_t)juce::jlimit(0, 16383, value14bit));
+    }
+
+    void setLocked(int sliderIndex, bool shouldBeLocked) noexcept
+    {
+        update(sliderIndex, LOCKED_BIT, shouldBeLocked ? LOCKED_BIT : 0);
+    }
+
+    void setAutomating(int sliderIndex, bool isAutomating) noexcept
+    {
+        update(sliderIndex, AUTOMATING_BIT, isAutomating ? AUTOMATING_BIT : 0);
+    }
+
+private:
+    static constexpr uint32_t VALUE_MASK = 0x3FFF;
+    static constexpr uint32_t LOCKED_BIT = 1u << 14;
+    static constexpr uint32_t AUTOMATING_BIT = 1u << 15;
+    static constexpr uint32_t STATE_MASK = VALUE_MASK | LOCKED_BIT | AUTOMATING_BIT;
+    static constexpr int VERSION_SHIFT = 16;
+
+    static SliderState unpack(uint32_t word) noexcept
+    {
+        SliderState state;
+        state.value14bit = (int)(word & VALUE_MASK);
+        state.isLocked = (word & LOCKED_BIT) != 0;
+        state.isAutomating = (word & AUTOMATING_BIT) != 0;
+        state.version = (uint16_t)(word >> VERSION_SHIFT);
+        return state;
+    }
+
+    void update(int sliderIndex, uint32_t fieldMask, uint32_t fieldValue) noexcept
+    {
+        if (!juce::isPositiveAndBelow(sliderIndex, NUM_SLIDERS))
+            return;
+
+        auto& word = states[(size_t)sliderIndex];
+        uint32_t current = word.load(std::memory_order_relaxed);
+        uint32_t updated;
+
+        do
+        {
+            if ((current & fieldMask) == fieldValue)
+                return;
+
+            uint32_t nextVersion = ((current >> VERSION_SHIFT) + 1) << VERSION_SHIFT;
+            updated = nextVersion | ((current & STATE_MASK & ~fieldMask) | fieldValue);
+        }
+        while (!word.compare_exchange_weak(current, updated, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        version.fetch_add(1, std::memory_order_release);
+    }
+
+    std::array<std::atomic<uint32_t>, NUM_SLIDERS> states;
+    std::atomic<uint32_t> version { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SliderStateStore)
+};
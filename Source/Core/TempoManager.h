@@ -2,6 +2,8 @@
 #pragma once
 #include <JuceHeader.h>
 #include <functional>
+#include <cmath>
+#include "MidiClockTracker.h"
 
 //==============================================================================
 class TempoManager
@@ -33,6 +35,9 @@ public:
         bpm = juce::jlimit(MIN_BPM, MAX_BPM, bpm);
         if (internalBPM != bpm)
         {
+            double now = juce::Time::getMillisecondCounterHiRes();
+            internalAnchorBeat += (now - internalAnchorTime) * internalBPM / 60000.0;
+            internalAnchorTime = now;
             internalBPM = bpm;
             DBG("TempoManager: Internal BPM set to " << bpm);
             
@@ -42,7 +47,7 @@ public:
         }
     }
     
-    // Set external BPM from DAW sync (future use)
+    // Set external BPM from DAW sync (MIDI clock, see applyMidiClock)
     void setExternalBPM(double bpm)
     {
         bool wasUsingExternal = useExternalBPM;
@@ -50,7 +55,12 @@ public:
         
         if (bpm > 0.0)
         {
-            externalBPM = juce::jlimit(MIN_BPM, MAX_BPM, bpm);
+            // Compare after clamping - an out-of-range clock would otherwise never match
+            bpm = juce::jlimit(MIN_BPM, MAX_BPM, bpm);
+            if (useExternalBPM && bpm == externalBPM)
+                return;
+            
+            externalBPM = bpm;
             useExternalBPM = true;
             DBG("TempoManager: External BPM set to " << externalBPM << " (DAW sync active)");
         }
@@ -164,84 +174,81 @@ public:
     }
     
     //==============================================================================
-    // MIDI Clock Infrastructure (for future DAW sync)
+    // External MIDI clock sync
     
-    // Process incoming MIDI clock messages
-    void processMIDIClock(const juce::MidiMessage& message)
+    // Apply the latest clock estimate from MidiManager (message thread). The estimate is
+    // fitted over timestamped ticks on the MIDI thread, so it arrives already de-jittered;
+    // changes below BPM_CHANGE_THRESHOLD are not re-announced.
+    void applyMidiClock(const MidiClockTracker::Snapshot& clock)
     {
-        if (message.isMidiClock())
-        {
-            // MIDI clock: 24 clocks per quarter note
-            clockCount++;
-            
-            if (clockCount >= 24)
-            {
-                // One quarter note has passed
-                clockCount = 0;
-                auto now = juce::Time::getMillisecondCounterHiRes();
-                
-                if (lastClockTime > 0.0)
-                {
-                    double timeSinceLastBeat = (now - lastClockTime) / 1000.0; // Convert to seconds
-                    if (timeSinceLastBeat > 0.0)
-                    {
-                        double calculatedBPM = 60.0 / timeSinceLastBeat; // 60 seconds per minute
-                        
-                        // Smooth BPM calculation to avoid jitter
-                        if (externalBPMHistory.size() >= BPM_HISTORY_SIZE)
-                            externalBPMHistory.removeFirst();
-                        
-                        externalBPMHistory.add(calculatedBPM);
-                        
-                        // Calculate average BPM from recent history
-                        double averageBPM = 0.0;
-                        for (auto bpm : externalBPMHistory)
-                            averageBPM += bpm;
-                        averageBPM /= externalBPMHistory.size();
-                        
-                        setExternalBPM(averageBPM);
-                    }
-                }
-                
-                lastClockTime = now;
-            }
-        }
-        else if (message.isMidiStart() || message.isMidiContinue())
+        bool transportChanged = clock.transportVersion != externalClock.transportVersion;
+        externalClock = clock;
+        
+        if (clock.isReceiving && clock.bpm > 0.0)
         {
-            clockCount = 0;
-            lastClockTime = 0.0;
-            DBG("TempoManager: MIDI clock start/continue received");
+            // Compared against the clamped value, so a clock outside MIN_BPM-MAX_BPM settles
+            double clampedBPM = juce::jlimit(MIN_BPM, MAX_BPM, clock.bpm);
+            if (!useExternalBPM || std::abs(clampedBPM - externalBPM) >= BPM_CHANGE_THRESHOLD)
+                setExternalBPM(clampedBPM);
         }
-        else if (message.isMidiStop())
+        else if (useExternalBPM)
         {
-            clockCount = 0;
-            lastClockTime = 0.0;
-            DBG("TempoManager: MIDI clock stop received");
-            // Could choose to disable external sync here if desired
+            DBG("TempoManager: MIDI clock lost");
+            setExternalBPM(0.0);
         }
+        
+        if (transportChanged && onTransportChanged)
+            onTransportChanged(clock.isRunning);
+    }
+    
+    // True while an external clock is running its transport (start/continue without stop)
+    bool isExternalTransportRunning() const { return useExternalBPM && externalClock.isRunning; }
+    
+    // Musical position in quarter notes at the given getMillisecondCounterHiRes() time.
+    // Follows the external clock's fitted phase when synced, otherwise a free-running
+    // internal clock that stays continuous across BPM changes.
+    double getBeatPositionAt(double timeMs) const
+    {
+        if (useExternalBPM)
+            return externalClock.getBeatPositionAt(timeMs);
+        
+        return internalAnchorBeat + (timeMs - internalAnchorTime) * internalBPM / 60000.0;
+    }
+    
+    // Length of one quarter note in ms. Follows the fitted external clock unclamped when
+    // synced, so it stays consistent with getBeatPositionAt().
+    double getMsPerBeat() const
+    {
+        if (useExternalBPM && externalClock.msPerTick > 0.0)
+            return externalClock.msPerTick * MidiClockTracker::TICKS_PER_BEAT;
+        
+        return 60000.0 / getCurrentBPM();
     }
     
     //==============================================================================
     // Callbacks for BPM changes
     std::function<void(double)> onBPMChanged;           // Called when active BPM changes
     std::function<void(bool)> onSyncModeChanged;       // Called when sync mode changes
+    std::function<void(bool)> onTransportChanged;      // External start/continue (true) or stop (false)
     
     //==============================================================================
     // Constants
     static constexpr double MIN_BPM = 60.0;
     static constexpr double MAX_BPM = 200.0;
     static constexpr double DEFAULT_BPM = 120.0;
+    static constexpr double BPM_CHANGE_THRESHOLD = 0.05;
     
 private:
     double internalBPM;                 // User-set BPM
     double externalBPM;                 // DAW-derived BPM
     bool useExternalBPM;                // Whether to use external BPM
     
-    // MIDI Clock tracking
-    int clockCount = 0;
-    double lastClockTime = 0.0;
-    static constexpr int BPM_HISTORY_SIZE = 8;
-    juce::Array<double> externalBPMHistory;
+    // External clock estimate (from MidiManager's MidiClockTracker)
+    MidiClockTracker::Snapshot externalClock;
+    
+    // Internal beat clock - re-anchored on BPM changes so the position never jumps
+    double internalAnchorTime = juce::Time::getMillisecondCounterHiRes();
+    double internalAnchorBeat = 0.0;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TempoManager)
 };
\ No newline at end of file
@@ -59,6 +59,12 @@ public:
         return currentValue;
     }
     
+    // Beats mode: the note length the knob shows, in quarter notes (a knob at zero stays off)
+    double getValueInBeats() const
+    {
+        return currentValue > 0.0 ? getClosestBeatValue(currentValue).beats : 0.0;
+    }
+    
     void setRange(double newMinValue, double newMaxValue)
     {
         minVal = newMinValue;
@@ -193,28 +199,31 @@ private:
         }
     }
     
-    juce::String secondsToBeats(double seconds) const
+    struct BeatValue {
+        double seconds;     // Knob position
+        double beats;       // Note length in quarter notes
+        juce::String text;
+    };
+    
+    static const BeatValue& getClosestBeatValue(double seconds)
     {
         // Beat conversion - independent scale using musical notation
         // 1/16, 1/8, 1/4, 1/2, 1, 2, 4, 8, 16 (representing 16th notes to 16 bars)
         
-        static const struct {
-            double seconds;
-            juce::String text;
-        } beatValues[] = {
-            {0.0, "1/16"},
-            {0.5, "1/8"}, 
-            {1.0, "1/4"},
-            {2.0, "1/2"},
-            {4.0, "1"},
-            {8.0, "2"},
-            {12.0, "4"},
-            {16.0, "8"},
-            {20.0, "16"}
+        static const BeatValue beatValues[] = {
+            {0.0, 0.25, "1/16"},
+            {0.5, 0.5, "1/8"}, 
+            {1.0, 1.0, "1/4"},
+            {2.0, 2.0, "1/2"},
+            {4.0, 4.0, "1"},
+            {8.0, 8.0, "2"},
+            {12.0, 16.0, "4"},
+            {16.0, 32.0, "8"},
+            {20.0, 64.0, "16"}
         };
         
         // Find the closest beat value
-        juce::String closestBeat = "1/16";
+        const BeatValue* closestBeat = &beatValues[0];
         double minDistance = std::abs(seconds - 0.0);
         
         for (const auto& beat : beatValues)
@@ -223,11 +232,16 @@ private:
             if (distance < minDistance)
             {
                 minDistance = distance;
-                closestBeat = beat.text;
+                closestBeat = &beat;
             }
         }
         
-        return closestBeat;
+        return *closestBeat;
+    }
+    
+    juce::String secondsToBeats(double seconds) const
+    {
+        return getClosestBeatValue(seconds).text;
     }
     
     void drawKnobShadow(juce::Graphics& g, juce::Rectangle<int> knobArea)
@@ -8,10 +8,12 @@
 #include "SettingsWindow.h"
 #include "MidiLearnWindow.h"
 #include "MidiMonitorWindow.h"
+#include "Core/CoreLog.h"
 #include "Core/MidiManager.h"
 #include "Core/KeyboardController.h"
 #include "Core/BankManager.h"
 #include "Core/Midi7BitController.h"
+#include "Core/TempoManager.h"
 #include "Core/AutomationConfigManager.h"
 #include "UI/AutomationConfigManagementWindow.h"
 #include "UI/MainControllerLayout.h"
@@ -39,8 +41,17 @@ public:
                 int midiChannel = settingsWindow.getMidiChannel();
                 int ccNumber = settingsWindow.getCCNumber(sliderIndex);
                 
+                // Automation yields wire bandwidth to manual moves on a paced port
+                auto priority = MidiOutputPriority::Manual;
+                if (automationEngine.isSliderAutomating(sliderIndex))
+                    priority = MidiOutputPriority::Automation;
+                
+                // Values driven by 7-bit input glide on the output thread instead of stepping
+                bool shouldSmooth = priority == MidiOutputPriority::Manual
+                                 && midi7BitController.isSliderDrivenByCoarseInput(sliderIndex);
+                
                 // Always use 14-bit output (compatible with both 7-bit and 14-bit receivers)
-                midiManager.sendCC14BitWithSlider(sliderIndex + 1, midiChannel, ccNumber, value);
+                midiManager.sendCC14BitWithSlider(sliderIndex + 1, midiChannel, ccNumber, value, priority, shouldSmooth);
                 
                 // Trigger MIDI activity indicator AFTER successful MIDI send
                 if (sliderIndex < sliderControls.size())
@@ -86,6 +97,8 @@ public:
             
             sliderControls.add(sliderControl);
             addAndMakeVisible(sliderControl);
+            sliderControl->setSliderStateStore(&sliderStateStore);
+            sliderControl->setAutomationEngine(&automationEngine);
             
             // Set up automation config manager
             sliderControl->setConfigManager(&automationConfigManager);
@@ -105,6 +118,17 @@ public:
                 return hasSliderMidiMapping(i);
             };
             
+            // Set up pre-scheduled automation output - timing comes from the MIDI backend's clock
+            sliderControl->onScheduleMidiOutput = [this](int sliderIndex, const std::vector<AutomationEngine::ScheduledPoint>& points) {
+                std::vector<MidiManager::ScheduledCCValue> values;
+                values.reserve(points.size());
+                for (const auto& point : points)
+                    values.push_back({ point.timeMs, (int)point.value });
+                
+                midiManager.scheduleCC14BitBlock(sliderIndex + 1, settingsWindow.getMidiChannel(),
+                                                 settingsWindow.getCCNumber(sliderIndex), values);
+            };
+            
             // Set up automation start/stop callback
             sliderControl->onAutomationToggled = [this](int sliderIndex, bool isStarting) {
                 if (isStarting) {
@@ -437,6 +461,49 @@ public:
         // Set up visibility change callback
         midiMonitorWindow->onVisibilityChanged = [this](bool isVisible) {
             updateMonitorButtonText(isVisible);
+            
+            // The output tap only records while someone is watching
+            midiManager.setMonitorAttached(isVisible);
+        };
+        
+        // Outgoing messages are batched in MidiManager and drained once per monitor frame
+        midiMonitorWindow->drainPendingMessages = [this]() {
+            MidiManager::OutgoingMonitorEvent event;
+            while (midiManager.popOutgoingMonitorEvent(event))
+            {
+                midiMonitorWindow->logOutgoingMessage(event.sliderNumber, event.channel, event.ccNumber,
+                                                      (event.value14bit >> 7) & 0x7F, event.value14bit & 0x7F, event.value14bit);
+            }
+        };
+        
+        // Status line: wire utilization per output port, throughput per input source
+        midiMonitorWindow->getOutputStatusText = [this]() {
+            juce::StringArray ports;
+            for (int port = 0; port < midiManager.getNumOutputPorts(); ++port)
+            {
+                juce::String status = "Out " + juce::String(port + 1) + ": "
+                                    + juce::String(midiManager.getWireUtilization(port) * 100.0f, 1) + "% ("
+                                    + juce::String((int)midiManager.getWireBytesPerSecond(port)) + " B/s)";
+                if (midiManager.getWireBaudRate(port) > 0)
+                    status += " deferred " + juce::String((juce::int64)midiManager.getDeferredOutputEventCount(port));
+                ports.add(status);
+            }
+            
+            // 7-bit input smoothing and the latency it adds
+            if (midiManager.isOutputSmoothingEnabled())
+                ports.add("Smoothing " + juce::String(midiManager.getOutputSmoothingRate()) + " Hz, +"
+                          + juce::String(midiManager.getOutputSmoothingLatencyMs(), 1) + " ms");
+            
+            // Input sources - throughput and what the enable flag/channel filter dropped
+            for (int sourceId : midiManager.getInputSourceIds())
+            {
+                auto statistics = midiManager.getInputSourceStatistics(sourceId);
+                ports.add("In " + midiManager.getInputSourceName(sourceId) + ": "
+                          + juce::String((int)statistics.messagesPerSecond) + " msg/s, filtered "
+                          + juce::String((juce::int64)statistics.filteredMessages) + ", echoes "
+                          + juce::String((juce::int64)statistics.suppressedEchoes));
+            }
+            return ports.joinIntoString("  |  ");
         };
         
         // Action tooltip - blueprint style (replaces movement speed tooltip)
@@ -455,6 +522,9 @@ public:
         windowSizeLabel.setFont(GlobalUIScale::getInstance().getScaledFont(10.0f));
         updateMidiTrackingDisplay();
         
+        // Route the shared automation engine to the sliders
+        setupAutomationEngine();
+        
         // Initialize MIDI Manager and set up callbacks
         setupMidiManager();
         
@@ -504,6 +574,9 @@ public:
         // CRITICAL: Stop all timers before destruction
         stopTimer();
         midi7BitController.stopTimer();
+        
+        // Stop automation while the sliders and MIDI manager it reports to still exist
+        automationEngine.stopAllAutomations();
 
         // Remove scale change listener
         GlobalUIScale::getInstance().removeScaleChangeListener(this);
@@ -806,15 +879,136 @@ public:
         }
     }
     
+    void setupAutomationEngine()
+    {
+        // One engine ticks every slider's automation; each tick's values arrive as one batch
+        automationEngine.onValuesUpdated = [this](const std::vector<AutomationEngine::ValueUpdate>& updates) {
+            for (const auto& update : updates)
+            {
+                if (auto* slider = sliderControls[update.sliderIndex])
+                    slider->applyAutomationValue(update.value);
+            }
+        };
+        
+        automationEngine.onAutomationStateChanged = [this](int sliderIndex, bool isAutomating) {
+            if (auto* slider = sliderControls[sliderIndex])
+                slider->handleAutomationStateChanged(isAutomating);
+        };
+        
+        automationEngine.onScheduleOutput = [this](int sliderIndex, const std::vector<AutomationEngine::ScheduledPoint>& points) {
+            if (auto* slider = sliderControls[sliderIndex])
+                slider->handleScheduledAutomationOutput(points);
+        };
+        
+        automationEngine.onScheduledOutputCancelled = [this](int) {
+            // Clearing is port-wide, so every other running automation re-renders from now
+            midiManager.cancelScheduledOutput();
+            automationEngine.rescheduleOutput();
+        };
+        
+        // Automation output runs on the engine's high-resolution clock, straight into the
+        // output queue; the engine's 16 ms timer only moves the sliders
+        automationEngine.onClockedOutput = [this](int sliderIndex, int value14bit) {
+            midiManager.sendSliderValue(sliderIndex + 1, value14bit, MidiOutputPriority::Automation);
+        };
+        automationEngine.setOutputClockRate(getAutomationClockRate());
+    }
+    
+    // Clocking values faster than the output thread drains them would only overwrite them
+    int getAutomationClockRate() const
+    {
+        return juce::jmin(AutomationEngine::DEFAULT_OUTPUT_CLOCK_HZ, midiManager.getOutputDrainRateHz());
+    }
     
     void setupMidiManager()
     {
         // Initialize MIDI devices
         midiManager.initializeDevices();
+        refreshOutputPorts();
+        
+        // Output ports opened and closed from the settings window
+        settingsWindow.onOutputDeviceAdded = [this](const juce::String& identifier) {
+            if (midiManager.addOutputDevice(identifier) < 0)
+                updateActionTooltip("Could not open MIDI output");
+            refreshOutputPorts();
+        };
+        
+        settingsWindow.onVirtualOutputAdded = [this]() {
+            juce::String name = "VMC14 Output " + juce::String(midiManager.getNumOutputPorts() + 1);
+            if (midiManager.addVirtualOutput(name) < 0)
+                updateActionTooltip("Virtual MIDI outputs are not supported on this platform");
+            refreshOutputPorts();
+        };
+        
+        settingsWindow.onUmpOutputAdded = [this](const juce::String& identifier) {
+            auto umpOutput = MidiUmpBytestreamOutput::open(identifier);
+            if (umpOutput == nullptr || midiManager.addUmpOutput(std::move(umpOutput)) < 0)
+                updateActionTooltip("Could not open MIDI output");
+            refreshOutputPorts();
+        };
+        
+        settingsWindow.onUmpOutputModeChanged = [this](bool useMidi2) {
+            midiManager.setUmpOutputEnabled(useMidi2);
+            updateActionTooltip(useMidi2 ? "UMP Output: MIDI 2.0" : "UMP Output: MIDI 1.0");
+        };
+        
+        // A rate of 0 turns the output clock off, so new automations pre-schedule their points
+        settingsWindow.onAutomationOutputModeChanged = [this](bool preScheduled) {
+            automationEngine.setOutputClockRate(preScheduled ? 0 : getAutomationClockRate());
+            updateActionTooltip(preScheduled ? "Automation Output: Pre-scheduled" : "Automation Output: Clocked");
+        };
+        
+        settingsWindow.onOutputPortRemoved = [this](int portIndex) {
+            midiManager.removeOutputPort(portIndex);
+            settingsWindow.removeOutputPortFromRouting(portIndex);
+            refreshOutputPorts();
+            updateSliderSettings();
+        };
         
         // Set up MIDI device selection callbacks
         midiLearnWindow.onMidiDeviceSelected = [this](const juce::String& deviceName) {
             midiManager.selectInputDevice(deviceName);
+            refreshInputSources();
+        };
+        
+        // Further inputs open alongside the selected device
+        midiLearnWindow.onInputSourceAdded = [this](const juce::String& deviceName) {
+            for (const auto& device : juce::MidiInput::getAvailableDevices())
+            {
+                if (device.name == deviceName)
+                {
+                    midiManager.addInputDevice(device.identifier);
+                    break;
+                }
+            }
+            refreshInputSources();
+        };
+        
+        midiLearnWindow.onInputSourceRemoved = [this](int sourceId) {
+            // The selected device goes through its selector so the saved preference follows
+            if (sourceId == midiManager.getSelectedInputSourceId())
+            {
+                midiManager.selectInputDevice("None");
+                midiLearnWindow.setSelectedDevice("None (Disable MIDI Input)");
+            }
+            else
+            {
+                midiManager.removeInputSource(sourceId);
+            }
+            refreshInputSources();
+        };
+        
+        midiLearnWindow.onInputSourceEnabledChanged = [this](int sourceId, bool shouldReceive) {
+            midiManager.setInputSourceEnabled(sourceId, shouldReceive);
+        };
+        
+        midiLearnWindow.onInputSourceChannelMaskChanged = [this](int sourceId, uint16_t channelMask) {
+            midiManager.setInputSourceChannelMask(sourceId, channelMask);
+        };
+        
+        midiLearnWindow.setHighResolutionInputEnabled(midiManager.isHighResolutionInputEnabled());
+        midiLearnWindow.onHighResolutionInputChanged = [this](bool shouldPair) {
+            midiManager.setHighResolutionInputEnabled(shouldPair);
         };
         
         midiLearnWindow.onMidiDevicesRefreshed = [this]() {
@@ -830,15 +1024,18 @@ public:
         midiManager.onMidiReceived = [this](int channel, int ccNumber, int ccValue) {
             int ourOutputChannel = settingsWindow.getMidiChannel();
             
-            // DEBUG: Log all incoming MIDI messages
-            juce::String debugMsg = "MIDI IN: Ch=" + juce::String(channel) + " CC=" + juce::String(ccNumber) + " Val=" + juce::String(ccValue) +
-                                   " (ourCh=" + juce::String(ourOutputChannel) + " learn=" + juce::String((int)midi7BitController.isInLearnMode()) +
-                                   " target=" + midi7BitController.getCurrentLearnTarget().getDisplayName() + ")";
-            DBG(debugMsg);
+            // MidiManager already dropped our own looped-back output, so every channel can be
+            // processed. Without echo suppression, fall back to ignoring our output channel.
+            bool isBlockedChannel = !midiManager.isEchoSuppressionEnabled() && channel == ourOutputChannel;
+            
+            // Per-event, so Trace - compiled out unless CORE_LOG_LEVEL is 0
+            CORE_LOG_TRACE("DebugMidiController", "MIDI IN: Ch=" << channel << " CC=" << ccNumber << " Val=" << ccValue
+                           << " (ourCh=" << ourOutputChannel << " learn=" << (int)midi7BitController.isInLearnMode()
+                           << " target=" << midi7BitController.getCurrentLearnTarget().getDisplayName() << ")");
             
             // === AUTOMATION CONFIG MIDI LEARN PAIRING ===
             // Check if we're waiting to pair a config with incoming MIDI
-            if (!midiLearnConfigId.isEmpty() && isInLearnMode && channel != ourOutputChannel)
+            if (!midiLearnConfigId.isEmpty() && isInLearnMode && !isBlockedChannel)
             {
                 DBG("MIDI Learn Pairing: Config " + midiLearnConfigId + " paired with Ch" + juce::String(channel) + " CC" + juce::String(ccNumber));
                 
@@ -880,22 +1077,37 @@ public:
             }
             
             // === MIDI FEEDBACK PREVENTION ===
-            // The app outputs MIDI on 'ourOutputChannel', so we must prevent processing
-            // incoming MIDI on the same channel to avoid feedback loops where:
+            // A loopback would otherwise feed our output straight back in:
             // Slider A sends CC -> MIDI loopback -> Slider B receives same CC -> moves Slider B
+            // Echo suppression removes exactly those messages; the channel block is the fallback.
+            if (isBlockedChannel)
+                return;
             
-            // 1. Activity Indicator: Only flash for external channels (not our output channel)
-            if (channel != ourOutputChannel)
+            if (!isTimerRunning())
+                startTimer(16);
+            repaint();
+            
+            midi7BitController.processIncomingCC(ccNumber, ccValue, channel);
+        };
+        
+        // Decoded 14-bit pairs (paired on the MIDI thread by MidiManager's input decoder)
+        midiManager.onHighResolutionMidiReceived = [this](int channel, int ccNumber, int value14bit) {
+            // Learn and config pairing only need the controller number - use the 7-bit path
+            if (isInLearnMode)
             {
-                if (!isTimerRunning())
-                    startTimer(16);
-                repaint();
-                
-                // 2. External Channel Processing: Process MIDI from external channels normally
-                midi7BitController.processIncomingCC(ccNumber, ccValue, channel);
+                midiManager.onMidiReceived(channel, ccNumber, value14bit >> 7);
+                return;
             }
             
-            // 3. Our Channel: Block all normal slider control to prevent feedback loops
+            // Same feedback prevention as 7-bit input
+            if (!midiManager.isEchoSuppressionEnabled() && channel == settingsWindow.getMidiChannel())
+                return;
+            
+            if (!isTimerRunning())
+                startTimer(16);
+            repaint();
+            
+            midi7BitController.processIncoming14BitCC(ccNumber, value14bit, channel);
         };
         
         // Set up connection status callback
@@ -910,6 +1122,7 @@ public:
         
         // Load saved MIDI device preference
         midiManager.loadDevicePreference();
+        refreshInputSources();
         
         // Update UI with current device selection
         if (!midiManager.getSelectedDeviceName().isEmpty())
@@ -918,18 +1131,48 @@ public:
             midiLearnWindow.setConnectionStatus(midiManager.getSelectedDeviceName(), midiManager.isInputConnected());
         }
         
-        // Set up MIDI monitor callbacks
-        midiManager.onMidiSent = [this](int sliderNumber, int midiChannel, int ccNumber, int msbValue, int lsbValue, int combinedValue) {
-            if (midiMonitorWindow)
-                midiMonitorWindow->logOutgoingMessage(sliderNumber, midiChannel, ccNumber, msbValue, lsbValue, combinedValue);
+        // External MIDI clock drives the tempo; the settings BPM is the internal fallback
+        tempoManager.setInternalBPM(settingsWindow.getBPM());
+        settingsWindow.onBPMChanged = [this](double bpm) {
+            tempoManager.setInternalBPM(bpm);
         };
+        midiManager.onMidiClockChanged = [this](const MidiClockTracker::Snapshot& clock) {
+            tempoManager.applyMidiClock(clock);
+            // Follow the external clock's fitted phase while its transport runs
+            if (tempoManager.isExternalTransportRunning())
+                updateAutomationBeatClock();
+        };
+        tempoManager.onBPMChanged = [this](double) {
+            settingsWindow.setSyncStatus(tempoManager.isUsingExternalSync(), tempoManager.getCurrentBPM());
+            updateAutomationBeatClock();
+        };
+        tempoManager.onSyncModeChanged = [this](bool isExternal) {
+            settingsWindow.setSyncStatus(isExternal, tempoManager.getCurrentBPM());
+            updateAutomationBeatClock();
+        };
+        tempoManager.onTransportChanged = [this](bool) {
+            updateAutomationBeatClock();
+        };
+        updateAutomationBeatClock();
         
+        // Set up MIDI monitor callbacks (outgoing messages are drained by the monitor itself)
         midiManager.onMidiReceiveForMonitor = [this](int midiChannel, int ccNumber, int value, const juce::String& source, int targetSlider) {
             if (midiMonitorWindow)
                 midiMonitorWindow->logIncomingMessage(midiChannel, ccNumber, value, source, targetSlider);
         };
     }
     
+    // Beat-timed automations run on the tempo manager's beat position. The engine's clock thread
+    // can't read the tempo manager, so it gets the current tempo line instead.
+    void updateAutomationBeatClock()
+    {
+        AutomationEngine::BeatClock beatClock;
+        beatClock.anchorTimeMs = juce::Time::getMillisecondCounterHiRes();
+        beatClock.anchorBeat = tempoManager.getBeatPositionAt(beatClock.anchorTimeMs);
+        beatClock.msPerBeat = tempoManager.getMsPerBeat();
+        automationEngine.setBeatClock(beatClock);
+    }
+    
     void setupBankManager()
     {
         // Set up bank manager callbacks
@@ -1003,23 +1246,7 @@ public:
             updateActionTooltip(speedText);
         };
         
-        keyboardController.isSliderLocked = [this](int sliderIndex) -> bool {
-            if (sliderIndex < sliderControls.size())
-            {
-                auto* slider = sliderControls[sliderIndex];
-                return slider ? slider->isLocked() : false;
-            }
-            return false;
-        };
-        
-        keyboardController.getSliderValue = [this](int sliderIndex) -> double {
-            if (sliderIndex < sliderControls.size())
-            {
-                auto* slider = sliderControls[sliderIndex];
-                return slider ? slider->getValue() : 0.0;
-            }
-            return 0.0;
-        };
+        keyboardController.setSliderStateStore(&sliderStateStore);
         
         keyboardController.getVisibleSliderIndex = [this](int keyboardPosition) -> int {
             return bankManager.getVisibleSliderIndex(keyboardPosition);
@@ -1089,25 +1316,8 @@ public:
                 sliderControls[sliderIndex]->triggerMidiActivity();
         };
         
-        // Set up slider locked check callback
-        midi7BitController.isSliderLocked = [this](int sliderIndex) -> bool {
-            if (sliderIndex < sliderControls.size())
-            {
-                auto* slider = sliderControls[sliderIndex];
-                return slider ? slider->isLocked() : false;
-            }
-            return false;
-        };
-        
-        // Set up get slider value callback
-        midi7BitController.getSliderValue = [this](int sliderIndex) -> double {
-            if (sliderIndex < sliderControls.size())
-            {
-                auto* slider = sliderControls[sliderIndex];
-                return slider ? slider->getValue() : 0.0;
-            }
-            return 0.0;
-        };
+        // Slider values and lock flags come from the shared state store
+        midi7BitController.setSliderStateStore(&sliderStateStore);
         
         // NEW: Set up bank cycle callback
         midi7BitController.onBankCycleRequested = [this]() {
@@ -1565,6 +1775,29 @@ private:
     }
     
     
+    void refreshInputSources()
+    {
+        std::vector<MidiLearnWindow::InputSourceInfo> sources;
+        for (int sourceId : midiManager.getInputSourceIds())
+        {
+            sources.push_back({ sourceId, midiManager.getInputSourceName(sourceId),
+                                midiManager.isInputSourceEnabled(sourceId),
+                                midiManager.getInputSourceChannelMask(sourceId) });
+        }
+        
+        midiLearnWindow.setInputSources(sources);
+    }
+    
+    void refreshOutputPorts()
+    {
+        juce::StringArray portNames;
+        for (int port = 0; port < midiManager.getNumOutputPorts(); ++port)
+            portNames.add(midiManager.getOutputPortName(port));
+        
+        settingsWindow.setOutputPorts(portNames);
+        settingsWindow.setMidi2OutputAvailable(midiManager.hasMidi2Output());
+    }
+    
     void updateSliderSettings()
     {
         for (int i = 0; i < sliderControls.size(); ++i)
@@ -1604,6 +1837,13 @@ private:
             bool useDeadzone = settingsWindow.getUseDeadzone(i);
             MidiInputMode mode = useDeadzone ? MidiInputMode::Deadzone : MidiInputMode::Direct;
             sliderControls[i]->setMidiInputMode(mode);
+            
+            // Update output port routing (slider numbers are 1-based in MidiManager)
+            midiManager.setSliderOutputRouting(i + 1, settingsWindow.getOutputRouting(i));
+            midiManager.setSliderController(i + 1, settingsWindow.getMidiChannel(), settingsWindow.getCCNumber(i));
+            
+            // Update NRPN/RPN addressing (ControlChange = plain CC pair on getCCNumber)
+            midiManager.setSliderParameter(i + 1, settingsWindow.getParameterType(i), settingsWindow.getParameterNumber(i));
         }
         
         // Trigger layout update when automation visibility changes
@@ -1892,88 +2132,6 @@ private:
     
     
     
-    void processMidiMSB(int sliderIndex, int ccNumber, int msbValue)
-    {
-        // NOTE: This method processes 14-bit MIDI MSB values from external sources only
-        // It should only be called from process7BitControl() which already has feedback prevention
-        // Store MSB value and timestamp
-        auto& state = midiCCStates[sliderIndex];
-        state.msbValue = msbValue;
-        state.msbTimestamp = juce::Time::getMillisecondCounterHiRes();
-        state.hasMSB = true;
-        
-        // If we have a recent LSB value, combine them
-        if (state.hasLSB && (state.msbTimestamp - state.lsbTimestamp) < MIDI_PAIR_TIMEOUT)
-        {
-            int combined14bit = (msbValue << 7) | state.lsbValue;
-            updateSliderFromMidiInput(sliderIndex, combined14bit);
-            
-            // Clear the state after using
-            state.hasMSB = false;
-            state.hasLSB = false;
-        }
-        else
-        {
-            // Use just MSB value (7-bit to 14-bit conversion)
-            int expanded14bit = msbValue << 7;
-            updateSliderFromMidiInput(sliderIndex, expanded14bit);
-        }
-    }
-    
-    void processMidiLSB(int sliderIndex, int baseCCNumber, int lsbValue)
-    {
-        // NOTE: This method processes 14-bit MIDI LSB values from external sources only
-        // It should only be called from process7BitControl() which already has feedback prevention
-        // Only process LSB if the base CC is < 96 (supports 14-bit)
-        if (baseCCNumber >= 96) return;
-        
-        auto& state = midiCCStates[sliderIndex];
-        state.lsbValue = lsbValue;
-        state.lsbTimestamp = juce::Time::getMillisecondCounterHiRes();
-        state.hasLSB = true;
-        
-        // If we have a recent MSB value, combine them
-        if (state.hasMSB && (state.lsbTimestamp - state.msbTimestamp) < MIDI_PAIR_TIMEOUT)
-        {
-            int combined14bit = (state.msbValue << 7) | lsbValue;
-            updateSliderFromMidiInput(sliderIndex, combined14bit);
-            
-            // Clear the state after using
-            state.hasMSB = false;
-            state.hasLSB = false;
-        }
-        // If no recent MSB, we wait for the next MSB message
-    }
-    
-    void updateSliderFromMidiInput(int sliderIndex, int value14bit)
-    {
-        // CRITICAL: This method moves sliders based on MIDI input
-        // It should ONLY be called for external MIDI (never from our own output)
-        // Feedback prevention is handled at handleIncomingMidiMessage() level
-        if (sliderIndex < sliderControls.size())
-        {
-            // Clamp value to valid range
-            int clampedValue = juce::jlimit(0, 16383, value14bit);
-            
-            // Thread-safe update to UI thread - check lock status on message thread
-            juce::MessageManager::callAsync([this, sliderIndex, clampedValue]() {
-                if (sliderIndex < sliderControls.size())
-                {
-                    auto* slider = sliderControls[sliderIndex];
-                    
-                    // Check if slider is locked (now on message thread)
-                    if (slider->isLocked())
-                        return;
-                        
-                    slider->setValueFromMIDI(clampedValue);
-                }
-            });
-        }
-    }
-    
-    
-    
-    
     void toggleLearnMode()
     {
         auto onLearnModeEnter = [this]() {
@@ -2064,6 +2222,8 @@ private:
     
     
     // UI Components
+    SliderStateStore sliderStateStore;     // Declared before the sliders that publish to it
+    AutomationEngine automationEngine;     // Shared by all sliders, outlives them
     juce::OwnedArray<SimpleSliderControl> sliderControls;
     juce::ToggleButton settingsButton;
     juce::TextButton modeButton;
@@ -2090,6 +2250,7 @@ private:
     KeyboardController keyboardController;
     BankManager bankManager;
     Midi7BitController midi7BitController;
+    TempoManager tempoManager;
     AutomationConfigManager automationConfigManager;
     
     // Layout and window managers
@@ -2211,21 +2372,6 @@ private:
         }
     }
     
-    // MIDI Input handling
-    struct MidiCCState
-    {
-        int msbValue = 0;
-        int lsbValue = 0;
-        double msbTimestamp = 0.0;
-        double lsbTimestamp = 0.0;
-        bool hasMSB = false;
-        bool hasLSB = false;
-    };
-    
-    std::array<MidiCCState, 16> midiCCStates; // State for each slider
-    static constexpr double MIDI_PAIR_TIMEOUT = 50.0; // milliseconds
-    
-    
     // MIDI input activity indicator
     juce::Rectangle<float> midiInputIndicatorBounds;
     static constexpr double MIDI_INPUT_ACTIVITY_DURATION = 150.0; // milliseconds
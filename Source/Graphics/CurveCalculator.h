@@ -1,6 +1,7 @@
 // CurveCalculator.h - Curve mathematics and point generation for automation visualization
 #pragma once
 #include <JuceHeader.h>
+#include "../Core/CurveTable.h"
 
 //==============================================================================
 class CurveCalculator
@@ -12,6 +13,10 @@ public:
         juce::Point<float> delayEndPoint;
         juce::Point<float> attackEndPoint;
         juce::Point<float> returnEndPoint;
+        
+        // Fetched from the cache once per calculation - the ball animation evaluates these directly
+        std::shared_ptr<const CurveTable> attackCurve;
+        std::shared_ptr<const CurveTable> returnCurve;
     };
     
     CurveCalculator() = default;
@@ -26,6 +31,10 @@ public:
         CurvePoints result;
         result.points.clear();
         
+        auto& curveCache = CurveTableCache::getInstance();
+        result.attackCurve = curveCache.getTableForCurve(curveValue);
+        result.returnCurve = curveCache.getTableForCurve(calculateInverseCurve(curveValue));
+        
         auto workingBounds = bounds.reduced(10.0f); // Margin for grid
         
         // If bounds are invalid, use default bounds
@@ -47,52 +56,22 @@ public:
         }
         
         // Normal curve calculation
-        calculateNormalCurve(result, workingBounds, delayTime, attackTime, returnTime, curveValue);
+        calculateNormalCurve(result, workingBounds, delayTime, attackTime, returnTime);
         
         return result;
     }
     
-    // Apply curve shape transformation
+    // Apply curve shape transformation - the same shared tables AutomationEngine evaluates.
+    // One-off lookups only; calculateCurvePoints() hands out the tables for repeated use.
     float applyCurve(float t, double curve) const
     {
-        // Must match AutomationEngine::applyCurve() behavior exactly
-        if (curve < 1.0)
-        {
-            // Exponential (0.0 = full exponential, slow start/fast finish)
-            double exponent = 1.0 + (1.0 - curve) * 3.0; // Range: 1.0 to 4.0
-            return std::pow(t, exponent);
-        }
-        else if (curve > 1.0)
-        {
-            // Logarithmic (2.0 = full logarithmic, fast start/slow finish)
-            double exponent = 1.0 / (1.0 + (curve - 1.0) * 3.0); // Range: 1.0 to 0.25
-            return std::pow(t, exponent);
-        }
-        else
-        {
-            // Linear curve (curve == 1.0)
-            return t;
-        }
+        return (float)CurveTableCache::getInstance().applyCurve(t, curve);
     }
 
     // Calculate inverse curve for return phase (matches AutomationEngine behavior)
     double calculateInverseCurve(double curveValue) const
     {
-        if (curveValue < 1.0)
-        {
-            // Attack was exponential, return should be logarithmic
-            return 1.0 + (1.0 - curveValue); // Maps 0.0->2.0, 1.0->1.0
-        }
-        else if (curveValue > 1.0)
-        {
-            // Attack was logarithmic, return should be exponential
-            return 1.0 - (curveValue - 1.0); // Maps 2.0->0.0, 1.0->1.0
-        }
-        else
-        {
-            // Attack was linear, return stays linear
-            return 1.0;
-        }
+        return CurveTable::getInverseCurve(curveValue);
     }
     
     // Calculate ball position for animation
@@ -134,7 +113,8 @@ public:
             attackProgress = juce::jlimit(0.0, 1.0, attackProgress);
 
             // Apply curve to the Y position like in curve generation
-            double curvedProgress = applyCurve(attackProgress, curveValue);
+            double curvedProgress = curvePoints.attackCurve != nullptr ? curvePoints.attackCurve->getValue(attackProgress)
+                                                                       : applyCurve((float)attackProgress, curveValue);
 
             float startX = curvePoints.delayEndPoint.x;
             float startY = curvePoints.delayEndPoint.y;
@@ -154,8 +134,8 @@ public:
             returnProgress = juce::jlimit(0.0, 1.0, returnProgress);
 
             // Apply inverse curve to match AutomationEngine behavior
-            double inverseCurve = calculateInverseCurve(curveValue);
-            double curvedProgress = applyCurve(returnProgress, inverseCurve);
+            double curvedProgress = curvePoints.returnCurve != nullptr ? curvePoints.returnCurve->getValue(returnProgress)
+                                                                       : applyCurve((float)returnProgress, calculateInverseCurve(curveValue));
 
             float startX = curvePoints.attackEndPoint.x;
             float startY = curvePoints.attackEndPoint.y;
@@ -193,7 +173,7 @@ private:
     }
     
     void calculateNormalCurve(CurvePoints& result, const juce::Rectangle<float>& bounds,
-                             double delayTime, double attackTime, double returnTime, double curveValue) const
+                             double delayTime, double attackTime, double returnTime) const
     {
         float originX = bounds.getX();
         float originY = bounds.getBottom();
@@ -231,11 +211,12 @@ private:
         
         if (attackWidth > 0.0f)
         {
+            const auto& attackCurve = result.attackCurve;
             int attackSteps = 20;
             for (int i = 1; i <= attackSteps; ++i)
             {
                 float t = i / (float)attackSteps;
-                float curvedT = applyCurve(t, curveValue);
+                float curvedT = (float)attackCurve->getValue(t);
                 
                 float x = result.delayEndPoint.x + (attackWidth * t);
                 float y = originY - (attackHeight * curvedT);
@@ -248,14 +229,14 @@ private:
         {
             result.returnEndPoint = {result.attackEndPoint.x + returnWidth, originY};
 
-            // Calculate inverse curve for return phase
-            double inverseCurve = calculateInverseCurve(curveValue);
+            // Inverse curve for the return phase
+            const auto& returnCurve = result.returnCurve;
 
             int returnSteps = 20; // Use same step count as attack for consistency
             for (int i = 1; i <= returnSteps; ++i)
             {
                 float t = i / (float)returnSteps;
-                float curvedT = applyCurve(t, inverseCurve); // Apply inverse curve exactly like AutomationEngine
+                float curvedT = (float)returnCurve->getValue(t); // Apply inverse curve exactly like AutomationEngine
                 float x = result.attackEndPoint.x + (returnWidth * t);
                 float y = result.attackEndPoint.y + ((originY - result.attackEndPoint.y) * curvedT);
                 result.points.push_back({x, y});
@@ -45,6 +45,19 @@ public:
             refreshMidiDevices();
         };
         
+        // Off by default: a device that uses CC 32-63 as controllers of their own would
+        // otherwise have them paired with CC 0-31
+        addAndMakeVisible(highResolutionInputToggle);
+        highResolutionInputToggle.setButtonText("Pair 14-bit CCs (0-31 + 32-63)");
+        highResolutionInputToggle.setToggleState(false, juce::dontSendNotification);
+        highResolutionInputToggle.setColour(juce::ToggleButton::textColourId, BlueprintColors::textPrimary());
+        highResolutionInputToggle.setColour(juce::ToggleButton::tickColourId, BlueprintColors::active());
+        highResolutionInputToggle.setColour(juce::ToggleButton::tickDisabledColourId, BlueprintColors::textSecondary());
+        highResolutionInputToggle.onClick = [this]() {
+            if (onHighResolutionInputChanged)
+                onHighResolutionInputChanged(highResolutionInputToggle.getToggleState());
+        };
+        
         addAndMakeVisible(connectionStatusLabel);
         connectionStatusLabel.setText("No device selected", juce::dontSendNotification);
         connectionStatusLabel.setFont(GlobalUIScale::getInstance().getScaledFont(11.0f));
@@ -53,6 +66,77 @@ public:
         connectionStatusLabel.setColour(juce::Label::backgroundColourId, juce::Colours::transparentBlack);
         connectionStatusLabel.setColour(juce::Label::outlineColourId, juce::Colours::transparentBlack);
         
+        // Input sources - every open device, each with its own enable flag and channel filter
+        addAndMakeVisible(inputSourcesLabel);
+        inputSourcesLabel.setText("Input Sources:", juce::dontSendNotification);
+        inputSourcesLabel.setFont(GlobalUIScale::getInstance().getScaledFont(14.0f).boldened());
+        inputSourcesLabel.setJustificationType(juce::Justification::centredLeft);
+        inputSourcesLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+        
+        addAndMakeVisible(addSourceCombo);
+        addSourceCombo.setTextWhenNothingSelected("Add another input...");
+        addSourceCombo.setColour(juce::ComboBox::backgroundColourId, BlueprintColors::inputBackground());
+        addSourceCombo.setColour(juce::ComboBox::textColourId, BlueprintColors::textPrimary());
+        addSourceCombo.setColour(juce::ComboBox::outlineColourId, BlueprintColors::blueprintLines());
+        
+        addAndMakeVisible(addSourceButton);
+        addSourceButton.setButtonText("Add");
+        addSourceButton.setLookAndFeel(&customButtonLookAndFeel);
+        addSourceButton.onClick = [this]() {
+            if (addSourceCombo.getSelectedId() > 0 && onInputSourceAdded)
+                onInputSourceAdded(addSourceCombo.getText());
+            addSourceCombo.setSelectedId(0, juce::dontSendNotification);
+        };
+        
+        addAndMakeVisible(inputSourcesCombo);
+        inputSourcesCombo.setTextWhenNothingSelected("No input open");
+        inputSourcesCombo.setColour(juce::ComboBox::backgroundColourId, BlueprintColors::inputBackground());
+        inputSourcesCombo.setColour(juce::ComboBox::textColourId, BlueprintColors::textPrimary());
+        inputSourcesCombo.setColour(juce::ComboBox::outlineColourId, BlueprintColors::blueprintLines());
+        inputSourcesCombo.onChange = [this]() {
+            updateSelectedSourceControls();
+        };
+        
+        addAndMakeVisible(sourceEnabledToggle);
+        sourceEnabledToggle.setButtonText("Enabled");
+        sourceEnabledToggle.setColour(juce::ToggleButton::textColourId, BlueprintColors::textPrimary());
+        sourceEnabledToggle.setColour(juce::ToggleButton::tickColourId, BlueprintColors::active());
+        sourceEnabledToggle.setColour(juce::ToggleButton::tickDisabledColourId, BlueprintColors::textSecondary());
+        sourceEnabledToggle.onClick = [this]() {
+            if (auto* source = getSelectedSource())
+            {
+                source->enabled = sourceEnabledToggle.getToggleState();
+                if (onInputSourceEnabledChanged)
+                    onInputSourceEnabledChanged(source->sourceId, source->enabled);
+            }
+        };
+        
+        addAndMakeVisible(removeSourceButton);
+        removeSourceButton.setButtonText("Remove");
+        removeSourceButton.setLookAndFeel(&customButtonLookAndFeel);
+        removeSourceButton.onClick = [this]() {
+            if (auto* source = getSelectedSource())
+                if (onInputSourceRemoved)
+                    onInputSourceRemoved(source->sourceId);
+        };
+        
+        addAndMakeVisible(channelFilterLabel);
+        channelFilterLabel.setText("Channels:", juce::dontSendNotification);
+        channelFilterLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+        channelFilterLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+        
+        for (int i = 0; i < 16; ++i)
+        {
+            auto* channelButton = new juce::ToggleButton(juce::String(i + 1));
+            channelFilterButtons.add(channelButton);
+            addAndMakeVisible(channelButton);
+            channelButton->setLookAndFeel(&customButtonLookAndFeel);
+            channelButton->setToggleState(true, juce::dontSendNotification);
+            channelButton->setTooltip("Receive channel " + juce::String(i + 1) + " from this input");
+            channelButton->onClick = [this]() { applyChannelFilter(); };
+        }
+        updateSelectedSourceControls();
+        
         // Initialize device list
         refreshMidiDevices();
         
@@ -116,6 +200,10 @@ public:
         // Clean up custom look and feel
         refreshDevicesButton.setLookAndFeel(nullptr);
         clearAllButton.setLookAndFeel(nullptr);
+        addSourceButton.setLookAndFeel(nullptr);
+        removeSourceButton.setLookAndFeel(nullptr);
+        for (auto* button : channelFilterButtons)
+            button->setLookAndFeel(nullptr);
         
         mappingRows.clear();
     }
@@ -190,10 +278,39 @@ public:
         inputDeviceCombo.setBounds(deviceRow.removeFromLeft(scale.getScaled(200)));
         deviceRow.removeFromLeft(scale.getScaled(10));
         refreshDevicesButton.setBounds(deviceRow.removeFromLeft(scale.getScaled(70)));
+        deviceRow.removeFromLeft(scale.getScaled(10));
+        highResolutionInputToggle.setBounds(deviceRow.removeFromLeft(scale.getScaled(240)));
         
         area.removeFromTop(scale.getScaled(5));
         connectionStatusLabel.setBounds(area.removeFromTop(scale.getScaled(20)));
-        area.removeFromTop(scale.getScaled(15));
+        area.removeFromTop(scale.getScaled(10));
+        
+        // Input sources section
+        inputSourcesLabel.setBounds(area.removeFromTop(scale.getScaled(20)));
+        area.removeFromTop(scale.getScaled(5));
+        
+        auto addSourceRow = area.removeFromTop(scale.getScaled(25));
+        addSourceCombo.setBounds(addSourceRow.removeFromLeft(scale.getScaled(200)));
+        addSourceRow.removeFromLeft(scale.getScaled(10));
+        addSourceButton.setBounds(addSourceRow.removeFromLeft(scale.getScaled(70)));
+        area.removeFromTop(scale.getScaled(5));
+        
+        auto sourceRow = area.removeFromTop(scale.getScaled(25));
+        inputSourcesCombo.setBounds(sourceRow.removeFromLeft(scale.getScaled(200)));
+        sourceRow.removeFromLeft(scale.getScaled(10));
+        removeSourceButton.setBounds(sourceRow.removeFromLeft(scale.getScaled(70)));
+        sourceRow.removeFromLeft(scale.getScaled(10));
+        sourceEnabledToggle.setBounds(sourceRow.removeFromLeft(scale.getScaled(90)));
+        area.removeFromTop(scale.getScaled(5));
+        
+        auto channelRow = area.removeFromTop(scale.getScaled(20));
+        channelFilterLabel.setBounds(channelRow.removeFromLeft(scale.getScaled(70)));
+        for (auto* button : channelFilterButtons)
+        {
+            button->setBounds(channelRow.removeFromLeft(scale.getScaled(20)));
+            channelRow.removeFromLeft(scale.getScaled(2));
+        }
+        area.removeFromTop(scale.getScaled(10));
         
         // Table headers
         auto headerBounds = getHeaderBounds();
@@ -367,6 +484,41 @@ public:
         }
     }
     
+    void setHighResolutionInputEnabled(bool shouldPair)
+    {
+        highResolutionInputToggle.setToggleState(shouldPair, juce::dontSendNotification);
+    }
+    
+    // Open input sources, as reported by MidiManager
+    struct InputSourceInfo
+    {
+        int sourceId = -1;
+        juce::String name;
+        bool enabled = true;
+        uint16_t channelMask = 0xFFFF;  // Bit 0 = channel 1
+    };
+    
+    void setInputSources(const std::vector<InputSourceInfo>& sources)
+    {
+        // Keep the same source selected across refreshes
+        int selectedSourceId = getSelectedSource() != nullptr ? getSelectedSource()->sourceId : -1;
+        inputSources = sources;
+        
+        inputSourcesCombo.clear(juce::dontSendNotification);
+        for (int i = 0; i < (int)inputSources.size(); ++i)
+            inputSourcesCombo.addItem(inputSources[(size_t)i].name, i + 1);
+        
+        int selectedIndex = 0;
+        for (int i = 0; i < (int)inputSources.size(); ++i)
+            if (inputSources[(size_t)i].sourceId == selectedSourceId)
+                selectedIndex = i;
+        
+        if (!inputSources.empty())
+            inputSourcesCombo.setSelectedId(selectedIndex + 1, juce::dontSendNotification);
+        
+        updateSelectedSourceControls();
+    }
+    
     // Callbacks
     std::function<void(int sliderIndex, int midiChannel, int ccNumber)> onMappingAdded;
     std::function<void(int sliderIndex)> onMappingCleared;
@@ -379,6 +531,13 @@ public:
     // MIDI device callbacks
     std::function<void(const juce::String& deviceName)> onMidiDeviceSelected;
     std::function<void()> onMidiDevicesRefreshed;
+    std::function<void(bool shouldPair)> onHighResolutionInputChanged;
+    
+    // Input source callbacks
+    std::function<void(const juce::String& deviceName)> onInputSourceAdded;
+    std::function<void(int sourceId)> onInputSourceRemoved;
+    std::function<void(int sourceId, bool shouldReceive)> onInputSourceEnabledChanged;
+    std::function<void(int sourceId, uint16_t channelMask)> onInputSourceChannelMaskChanged;
     
     // GlobalUIScale::ScaleChangeListener implementation
     void scaleFactorChanged(float newScale) override
@@ -393,6 +552,8 @@ public:
         // Update all label text colors
         titleLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
         inputDeviceLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+        inputSourcesLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+        channelFilterLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
         connectionStatusLabel.setColour(juce::Label::textColourId, BlueprintColors::textSecondary());
         sliderHeaderLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
         sliderHeaderLabel.setColour(juce::Label::backgroundColourId, BlueprintColors::background());
@@ -408,6 +569,18 @@ public:
         inputDeviceCombo.setColour(juce::ComboBox::backgroundColourId, BlueprintColors::inputBackground());
         inputDeviceCombo.setColour(juce::ComboBox::textColourId, BlueprintColors::textPrimary());
         inputDeviceCombo.setColour(juce::ComboBox::outlineColourId, BlueprintColors::blueprintLines());
+        highResolutionInputToggle.setColour(juce::ToggleButton::textColourId, BlueprintColors::textPrimary());
+        highResolutionInputToggle.setColour(juce::ToggleButton::tickColourId, BlueprintColors::active());
+        highResolutionInputToggle.setColour(juce::ToggleButton::tickDisabledColourId, BlueprintColors::textSecondary());
+        for (auto* combo : { &addSourceCombo, &inputSourcesCombo })
+        {
+            combo->setColour(juce::ComboBox::backgroundColourId, BlueprintColors::inputBackground());
+            combo->setColour(juce::ComboBox::textColourId, BlueprintColors::textPrimary());
+            combo->setColour(juce::ComboBox::outlineColourId, BlueprintColors::blueprintLines());
+        }
+        sourceEnabledToggle.setColour(juce::ToggleButton::textColourId, BlueprintColors::textPrimary());
+        sourceEnabledToggle.setColour(juce::ToggleButton::tickColourId, BlueprintColors::active());
+        sourceEnabledToggle.setColour(juce::ToggleButton::tickDisabledColourId, BlueprintColors::textSecondary());
 
         // Update mapping row colors
         for (auto& row : mappingRows)
@@ -546,6 +719,7 @@ private:
         area.reduce(scale.getScaled(10), scale.getScaled(10));
         area.removeFromTop(scale.getScaled(40)); // Title + gap
         area.removeFromTop(scale.getScaled(85)); // MIDI device selection area (20+5+25+5+20+10)
+        area.removeFromTop(scale.getScaled(115)); // Input sources area (20+5+25+5+25+5+20+10)
         return area.removeFromTop(scale.getScaled(25));
     }
     
@@ -556,6 +730,7 @@ private:
         area.reduce(scale.getScaled(10), scale.getScaled(10));
         area.removeFromTop(scale.getScaled(40)); // Title + gap
         area.removeFromTop(scale.getScaled(85)); // MIDI device selection area
+        area.removeFromTop(scale.getScaled(115)); // Input sources area
         area.removeFromBottom(scale.getScaled(60)); // Bottom area
         return area;
     }
@@ -575,6 +750,44 @@ private:
         }
     }
     
+    InputSourceInfo* getSelectedSource()
+    {
+        int index = inputSourcesCombo.getSelectedId() - 1;
+        return juce::isPositiveAndBelow(index, (int)inputSources.size()) ? &inputSources[(size_t)index] : nullptr;
+    }
+    
+    void updateSelectedSourceControls()
+    {
+        auto* source = getSelectedSource();
+        
+        sourceEnabledToggle.setEnabled(source != nullptr);
+        removeSourceButton.setEnabled(source != nullptr);
+        sourceEnabledToggle.setToggleState(source != nullptr && source->enabled, juce::dontSendNotification);
+        
+        for (int i = 0; i < channelFilterButtons.size(); ++i)
+        {
+            channelFilterButtons[i]->setEnabled(source != nullptr);
+            channelFilterButtons[i]->setToggleState(source == nullptr || (source->channelMask & (1u << i)) != 0,
+                                                    juce::dontSendNotification);
+        }
+    }
+    
+    void applyChannelFilter()
+    {
+        auto* source = getSelectedSource();
+        if (source == nullptr)
+            return;
+        
+        uint16_t channelMask = 0;
+        for (int i = 0; i < channelFilterButtons.size(); ++i)
+            if (channelFilterButtons[i]->getToggleState())
+                channelMask |= (uint16_t)(1u << i);
+        
+        source->channelMask = channelMask;
+        if (onInputSourceChannelMaskChanged)
+            onInputSourceChannelMaskChanged(source->sourceId, channelMask);
+    }
+    
     void updateStatusLabel()
     {
         int count = mappingRows.size();
@@ -589,6 +802,8 @@ private:
         // Update all label fonts
         titleLabel.setFont(scale.getScaledFont(18.0f).boldened());
         inputDeviceLabel.setFont(scale.getScaledFont(14.0f).boldened());
+        inputSourcesLabel.setFont(scale.getScaledFont(14.0f).boldened());
+        channelFilterLabel.setFont(scale.getScaledFont(12.0f));
         connectionStatusLabel.setFont(scale.getScaledFont(11.0f));
         sliderHeaderLabel.setFont(scale.getScaledFont(12.0f).boldened());
         channelHeaderLabel.setFont(scale.getScaledFont(12.0f).boldened());
@@ -606,6 +821,7 @@ private:
     void refreshMidiDevices()
     {
         inputDeviceCombo.clear();
+        addSourceCombo.clear(juce::dontSendNotification);
         
         // Add "None" option
         inputDeviceCombo.addItem("None (Disable MIDI Input)", 1);
@@ -626,6 +842,7 @@ private:
             {
                 auto deviceInfo = midiInputs[i];
                 inputDeviceCombo.addItem(deviceInfo.name, i + 10); // Start IDs from 10
+                addSourceCombo.addItem(deviceInfo.name, i + 1);
             }
             
             // Update status
@@ -643,8 +860,20 @@ private:
     juce::Label inputDeviceLabel;
     juce::ComboBox inputDeviceCombo;
     juce::TextButton refreshDevicesButton;
+    juce::ToggleButton highResolutionInputToggle;
     juce::Label connectionStatusLabel;
     
+    // Input source UI components
+    juce::Label inputSourcesLabel;
+    juce::ComboBox addSourceCombo;
+    juce::TextButton addSourceButton;
+    juce::ComboBox inputSourcesCombo;
+    juce::TextButton removeSourceButton;
+    juce::ToggleButton sourceEnabledToggle;
+    juce::Label channelFilterLabel;
+    juce::OwnedArray<juce::ToggleButton> channelFilterButtons;
+    std::vector<InputSourceInfo> inputSources;
+    
     // UI components
     juce::Label titleLabel;
     juce::Label sliderHeaderLabel;
@@ -1,4 +1,5 @@
 #include "MidiMonitorWindow.h"
+#include "Core/LatencyTracer.h"
 
 //==============================================================================
 class MidiMonitorContent : public juce::Component
@@ -19,7 +20,7 @@ public:
         int columnWidth = (bounds.getWidth() - 20) / 2;
         int separatorX = 10 + columnWidth;
         g.setColour(BlueprintColors::blueprintLines().withAlpha(0.6f));
-        g.drawVerticalLine(separatorX, 60, bounds.getHeight() - 50);
+        g.drawVerticalLine(separatorX, 60, bounds.getHeight() - 70);
     }
     
     void resized() override
@@ -40,13 +41,19 @@ public:
         area.removeFromTop(5);
         
         // Bottom controls
-        auto bottomArea = area.removeFromBottom(30);
+        auto bottomArea = area.removeFromBottom(50);
         bottomArea.removeFromTop(5);
         
         auto buttonArea = bottomArea.removeFromBottom(25);
         clearButton.setBounds(buttonArea.removeFromLeft(80));
         buttonArea.removeFromLeft(10);
         pauseButton.setBounds(buttonArea.removeFromLeft(80));
+        buttonArea.removeFromLeft(10);
+        exportLatencyButton.setBounds(buttonArea.removeFromLeft(110));
+        buttonArea.removeFromLeft(10);
+        outputStatusLabel.setBounds(buttonArea);
+        
+        latencyStatusLabel.setBounds(bottomArea);
         
         // Text areas (remaining space)
         columnWidth = area.getWidth() / 2;
@@ -66,6 +73,9 @@ private:
     juce::TextEditor incomingTextArea;
     juce::TextButton clearButton;
     juce::ToggleButton pauseButton;
+    juce::TextButton exportLatencyButton;
+    juce::Label outputStatusLabel;
+    juce::Label latencyStatusLabel;
     
     // Custom look and feel
     CustomButtonLookAndFeel customButtonLookAndFeel;
@@ -117,16 +127,37 @@ private:
             owner.setPaused(pauseButton.getToggleState());
             pauseButton.setButtonText(owner.isPaused() ? "Resume" : "Pause");
         };
+        
+        // Latency histograms to CSV
+        addAndMakeVisible(exportLatencyButton);
+        exportLatencyButton.setButtonText("Export Latency");
+        exportLatencyButton.setLookAndFeel(&customButtonLookAndFeel);
+        exportLatencyButton.onClick = [this]() { owner.exportLatencyCsv(); };
+        
+        // Output wire statistics
+        addAndMakeVisible(outputStatusLabel);
+        outputStatusLabel.setFont(juce::FontOptions(11.0f));
+        outputStatusLabel.setJustificationType(juce::Justification::centredRight);
+        outputStatusLabel.setColour(juce::Label::textColourId, BlueprintColors::textSecondary());
+        
+        // Input-to-output latency percentiles
+        addAndMakeVisible(latencyStatusLabel);
+        latencyStatusLabel.setFont(juce::FontOptions(11.0f));
+        latencyStatusLabel.setJustificationType(juce::Justification::centredLeft);
+        latencyStatusLabel.setColour(juce::Label::textColourId, BlueprintColors::textSecondary());
     }
     
 public:
     juce::TextEditor& getOutgoingTextArea() { return outgoingTextArea; }
     juce::TextEditor& getIncomingTextArea() { return incomingTextArea; }
+    juce::Label& getOutputStatusLabel() { return outputStatusLabel; }
+    juce::Label& getLatencyStatusLabel() { return latencyStatusLabel; }
     
     ~MidiMonitorContent()
     {
         clearButton.setLookAndFeel(nullptr);
         pauseButton.setLookAndFeel(nullptr);
+        exportLatencyButton.setLookAndFeel(nullptr);
     }
 };
 
@@ -268,6 +299,9 @@ void MidiMonitorWindow::clearMessages()
     lastOutgoingDisplay.clear();
     lastIncomingDisplay.clear();
     
+    // Start a fresh latency measurement along with the fresh log
+    LatencyTracer::getInstance().reset();
+    
     // Clear text areas immediately
     if (content)
     {
@@ -281,11 +315,36 @@ void MidiMonitorWindow::setPaused(bool shouldPause)
     paused = shouldPause;
 }
 
+void MidiMonitorWindow::exportLatencyCsv()
+{
+    auto defaultFile = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                           .getChildFile("latency_" + juce::Time::getCurrentTime().formatted("%Y%m%d_%H%M%S") + ".csv");
+    
+    auto chooser = std::make_shared<juce::FileChooser>("Export latency histograms", defaultFile, "*.csv");
+    
+    chooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles
+                             | juce::FileBrowserComponent::warnAboutOverwriting,
+                         [chooser](const juce::FileChooser&)
+                         {
+                             auto result = chooser->getResult();
+                             if (result != juce::File())
+                                 LatencyTracer::getInstance().exportCsv(result.withFileExtension("csv"));
+                         });
+}
+
 //==============================================================================
 void MidiMonitorWindow::updateTextAreas()
 {
     if (!content) return;
     
+    if (drainPendingMessages)
+        drainPendingMessages();
+    
+    if (getOutputStatusText)
+        content->getOutputStatusLabel().setText(getOutputStatusText(), juce::dontSendNotification);
+    
+    content->getLatencyStatusLabel().setText(LatencyTracer::getInstance().getSummaryText(), juce::dontSendNotification);
+    
     std::lock_guard<std::mutex> lock(messagesMutex);
     
     // Generate current display strings
@@ -118,6 +118,12 @@ public:
     // Visibility change callback
     std::function<void(bool isVisible)> onVisibilityChanged;
     
+    // Polled on each display update for the output status line (e.g. wire utilization)
+    std::function<juce::String()> getOutputStatusText;
+    
+    // Called once per display update, before drawing, to log messages batched since the last one
+    std::function<void()> drainPendingMessages;
+    
     // Message logging methods (thread-safe)
     void logOutgoingMessage(int sliderNumber, int midiChannel, int ccNumber, int msbValue, int lsbValue, int combinedValue);
     void logIncomingMessage(int midiChannel, int ccNumber, int value, const juce::String& source, int targetSlider = -1);
@@ -126,6 +132,7 @@ public:
     void clearMessages();
     void setPaused(bool shouldPause);
     bool isPaused() const { return paused; }
+    void exportLatencyCsv();    // Asks for a file, then writes LatencyTracer's histograms as CSV
     
     // Public method for content component access
     void setupTextEditor(juce::TextEditor& editor);
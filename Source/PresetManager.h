@@ -19,6 +19,9 @@ struct SliderPreset
     double bipolarCenter = 8191.5; // Default center value
     juce::String customName = "";
     bool showAutomation = true; // Default to automation shown
+    int outputRouting = -1; // Bitmask of output ports, -1 = all ports
+    int parameterType = 0; // 0=CC pair, 1=NRPN, 2=RPN
+    int parameterNumber = 0; // NRPN/RPN number (0-16383)
     
     juce::var toVar() const
     {
@@ -37,6 +40,9 @@ struct SliderPreset
         obj->setProperty("bipolarCenter", bipolarCenter);
         obj->setProperty("customName", customName);
         obj->setProperty("showAutomation", showAutomation);
+        obj->setProperty("outputRouting", outputRouting);
+        obj->setProperty("parameterType", parameterType);
+        obj->setProperty("parameterNumber", parameterNumber);
 
         return juce::var(obj);
     }
@@ -59,6 +65,9 @@ struct SliderPreset
             bipolarCenter = obj->hasProperty("bipolarCenter") ? (double)obj->getProperty("bipolarCenter") : 8191.5;
             customName = obj->hasProperty("customName") ? obj->getProperty("customName").toString() : "";
             showAutomation = obj->hasProperty("showAutomation") ? (bool)obj->getProperty("showAutomation") : true;
+            outputRouting = obj->hasProperty("outputRouting") ? (int)obj->getProperty("outputRouting") : -1;
+            parameterType = obj->hasProperty("parameterType") ? (int)obj->getProperty("parameterType") : 0;
+            parameterNumber = obj->hasProperty("parameterNumber") ? (int)obj->getProperty("parameterNumber") : 0;
 
         }
     }
@@ -4,6 +4,7 @@
 #include "PresetManager.h"
 #include "CustomLookAndFeel.h"
 #include "Core/SliderDisplayManager.h"
+#include "Core/MidiOutputQueue.h"
 #include "UI/GlobalSettingsTab.h"
 #include "UI/ControllerSettingsTab.h"
 #include "UI/PresetManagementTab.h"
@@ -57,6 +58,16 @@ public:
     BipolarSettings getBipolarSettings(int sliderIndex) const;
     juce::String getSliderDisplayName(int sliderIndex) const;
     bool getShowAutomation(int sliderIndex) const;
+    uint32_t getOutputRouting(int sliderIndex) const;
+    void setOutputRouting(int sliderIndex, uint32_t portMask);
+    MidiParameterType getParameterType(int sliderIndex) const;
+    int getParameterNumber(int sliderIndex) const;
+    void setParameter(int sliderIndex, MidiParameterType type, int parameterNumber);
+    
+    // Output ports - names listed in the global tab, count sets the per-slider routing toggles
+    void setOutputPorts(const juce::StringArray& portNames);
+    void setMidi2OutputAvailable(bool isAvailable);
+    void removeOutputPortFromRouting(int portIndex); // Later ports move down one index
     
     // BPM management methods
     void setBPM(double bpm);
@@ -71,6 +82,12 @@ public:
     std::function<void(int)> onBankSelectionChanged;
     std::function<void(int)> onSliderReset;
     std::function<void(int, MidiInputMode)> onSliderMidiInputModeChanged;
+    std::function<void(const juce::String&)> onOutputDeviceAdded; // Device identifier
+    std::function<void()> onVirtualOutputAdded;
+    std::function<void(const juce::String&)> onUmpOutputAdded; // Device identifier
+    std::function<void(int)> onOutputPortRemoved; // Port index
+    std::function<void(bool)> onUmpOutputModeChanged;
+    std::function<void(bool)> onAutomationOutputModeChanged; // true = pre-scheduled
     
     // Keyboard handling
     bool keyPressed(const juce::KeyPress& key) override;
@@ -109,6 +126,9 @@ private:
         BipolarSettings bipolarSettings;
         juce::String customName = "";
         bool showAutomation = true; // NEW: Default to automation shown
+        int outputRouting = -1; // Bitmask of output ports, -1 = all ports
+        MidiParameterType parameterType = MidiParameterType::ControlChange; // CC pair or NRPN/RPN
+        int parameterNumber = 0; // NRPN/RPN number (0-16383)
         
         SliderSettings()
         {
@@ -123,6 +143,9 @@ private:
             bipolarSettings = BipolarSettings(); // Center value now auto-calculated
             customName = "";
             showAutomation = true; // Default to automation shown
+            outputRouting = -1;
+            parameterType = MidiParameterType::ControlChange;
+            parameterNumber = 0;
         }
         
         // Update bipolar center when range changes
@@ -232,6 +255,36 @@ inline void SettingsWindow::setupCommunication()
         if (onBPMChanged)
             onBPMChanged(bpm);
     };
+    
+    globalTab->onOutputDeviceAdded = [this](const juce::String& identifier) {
+        if (onOutputDeviceAdded)
+            onOutputDeviceAdded(identifier);
+    };
+    
+    globalTab->onVirtualOutputAdded = [this]() {
+        if (onVirtualOutputAdded)
+            onVirtualOutputAdded();
+    };
+    
+    globalTab->onUmpOutputAdded = [this](const juce::String& identifier) {
+        if (onUmpOutputAdded)
+            onUmpOutputAdded(identifier);
+    };
+    
+    globalTab->onOutputPortRemoved = [this](int portIndex) {
+        if (onOutputPortRemoved)
+            onOutputPortRemoved(portIndex);
+    };
+    
+    globalTab->onUmpOutputModeChanged = [this](bool useMidi2) {
+        if (onUmpOutputModeChanged)
+            onUmpOutputModeChanged(useMidi2);
+    };
+    
+    globalTab->onAutomationOutputModeChanged = [this](bool preScheduled) {
+        if (onAutomationOutputModeChanged)
+            onAutomationOutputModeChanged(preScheduled);
+    };
 
 
     globalTab->onRequestFocus = [this]() {
@@ -370,6 +423,9 @@ inline void SettingsWindow::initializeSliderData()
         settings.bipolarSettings = BipolarSettings(); // Center value now auto-calculated
         settings.customName = ""; // Clear custom names on reset
         settings.showAutomation = true; // Reset to default automation visibility
+        settings.outputRouting = -1;
+        settings.parameterType = MidiParameterType::ControlChange;
+        settings.parameterNumber = 0;
         
         // Set default colors based on bank (using direct mapping 0-7)
         int bankIndex = i / 4;
@@ -510,6 +566,9 @@ inline ControllerPreset SettingsWindow::getCurrentPreset() const
             // bipolarCenter removed - now automatically calculated from range
             preset.sliders.getReference(i).customName = settings.customName;
             preset.sliders.getReference(i).showAutomation = settings.showAutomation;
+            preset.sliders.getReference(i).outputRouting = settings.outputRouting;
+            preset.sliders.getReference(i).parameterType = static_cast<int>(settings.parameterType);
+            preset.sliders.getReference(i).parameterNumber = settings.parameterNumber;
         }
     }
     
@@ -538,6 +597,9 @@ inline void SettingsWindow::applyPreset(const ControllerPreset& preset)
         // bipolarCenter removed - now automatically calculated from range
         settings.customName = sliderPreset.customName;
         settings.showAutomation = sliderPreset.showAutomation;
+        settings.outputRouting = sliderPreset.outputRouting;
+        settings.parameterType = static_cast<MidiParameterType>(juce::jlimit(0, 2, sliderPreset.parameterType));
+        settings.parameterNumber = juce::jlimit(0, 16383, sliderPreset.parameterNumber);
         
         // Apply orientation to the actual slider
         applyOrientationToSlider(i);
@@ -675,6 +737,9 @@ inline void SettingsWindow::resetSlider(int sliderIndex)
     settings.bipolarSettings = BipolarSettings();
     settings.customName = "";
     settings.showAutomation = true;
+    settings.outputRouting = -1;
+    settings.parameterType = MidiParameterType::ControlChange;
+    settings.parameterNumber = 0;
 
     // Set default color based on bank
     int bankIndex = sliderIndex / 4;
@@ -776,6 +841,78 @@ inline bool SettingsWindow::getShowAutomation(int sliderIndex) const
     return true; // Default to automation shown
 }
 
+inline uint32_t SettingsWindow::getOutputRouting(int sliderIndex) const
+{
+    if (sliderIndex >= 0 && sliderIndex < 16)
+        return (uint32_t)sliderSettingsData[sliderIndex].outputRouting;
+    return 0xFFFFFFFF; // Default to all output ports
+}
+
+inline void SettingsWindow::setOutputPorts(const juce::StringArray& portNames)
+{
+    globalTab->setOutputPorts(portNames);
+    controllerTab->setNumOutputPorts(portNames.size());
+}
+
+inline void SettingsWindow::setMidi2OutputAvailable(bool isAvailable)
+{
+    globalTab->setMidi2OutputAvailable(isAvailable);
+}
+
+inline void SettingsWindow::removeOutputPortFromRouting(int portIndex)
+{
+    if (portIndex < 0 || portIndex >= 32)
+        return;
+    
+    // Same shift MidiManager applies to its own routing table
+    uint32_t lowerBits = (1u << portIndex) - 1;
+    for (auto& settings : sliderSettingsData)
+    {
+        auto mask = (uint32_t)settings.outputRouting;
+        if (mask != 0xFFFFFFFF)
+            settings.outputRouting = (int)((mask & lowerBits) | ((mask >> 1) & ~lowerBits));
+    }
+    
+    updateControlsForSelectedSlider();
+}
+
+inline void SettingsWindow::setOutputRouting(int sliderIndex, uint32_t portMask)
+{
+    if (sliderIndex < 0 || sliderIndex >= 16)
+        return;
+    
+    sliderSettingsData[sliderIndex].outputRouting = (int)portMask;
+    
+    if (onSettingsChanged)
+        onSettingsChanged();
+}
+
+inline MidiParameterType SettingsWindow::getParameterType(int sliderIndex) const
+{
+    if (sliderIndex >= 0 && sliderIndex < 16)
+        return sliderSettingsData[sliderIndex].parameterType;
+    return MidiParameterType::ControlChange;
+}
+
+inline int SettingsWindow::getParameterNumber(int sliderIndex) const
+{
+    if (sliderIndex >= 0 && sliderIndex < 16)
+        return sliderSettingsData[sliderIndex].parameterNumber;
+    return 0;
+}
+
+inline void SettingsWindow::setParameter(int sliderIndex, MidiParameterType type, int parameterNumber)
+{
+    if (sliderIndex < 0 || sliderIndex >= 16)
+        return;
+    
+    sliderSettingsData[sliderIndex].parameterType = type;
+    sliderSettingsData[sliderIndex].parameterNumber = juce::jlimit(0, 16383, parameterNumber);
+    
+    if (onSettingsChanged)
+        onSettingsChanged();
+}
+
 inline bool SettingsWindow::keyPressed(const juce::KeyPress& key)
 {
     if (key == juce::KeyPress::escapeKey)
@@ -851,6 +988,9 @@ inline void SettingsWindow::saveCurrentSliderSettings()
         settings.bipolarSettings.snapThreshold = controllerTab->getCurrentSnapThreshold();
         settings.customName = controllerTab->getCurrentCustomName();
         settings.showAutomation = controllerTab->getCurrentShowAutomation();
+        settings.outputRouting = (int)controllerTab->getCurrentOutputRouting();
+        settings.parameterType = controllerTab->getCurrentParameterType();
+        settings.parameterNumber = juce::jlimit(0, 16383, controllerTab->getCurrentParameterNumber());
         
         // Bipolar center automatically calculated - no manual update needed
         
@@ -882,6 +1022,8 @@ inline void SettingsWindow::updateControlsForSelectedSlider()
             settings.bipolarSettings.snapThreshold,
             settings.showAutomation
         );
+        controllerTab->setOutputRouting((uint32_t)settings.outputRouting);
+        controllerTab->setParameter(settings.parameterType, settings.parameterNumber);
         
         controllerTab->updateControlsForSelectedSlider(selectedSlider);
         controllerTab->updateBankSelectorAppearance(selectedBank);
@@ -10,6 +10,8 @@
 #include "Core/SliderDisplayManager.h"
 #include "Core/AutomationConfigManager.h"
 #include "Core/AutomationConfig.h"
+#include "Core/LatencyTracer.h"
+#include "Core/SliderStateStore.h"
 #include "Components/SliderInteractionHandler.h"
 #include "Components/AutomationControlPanel.h"
 #include "Components/SliderLearnZones.h"
@@ -200,7 +202,7 @@ public:
         
         // Safe callback - update label and send MIDI
         mainSlider.onValueChange = [this]() {
-            if (!automationEngine.isSliderAutomating(index)) // Only update if not currently automating
+            if (!isAutomating()) // Only update if not currently automating
             {
                 double rawValue = mainSlider.getValue();
                 
@@ -213,19 +215,16 @@ public:
                     double max = mainSlider.getMaximum();
                     rawValue = max - (rawValue - min);
                     // Set the inverted value without triggering this callback again
-                    isSettingValueProgrammatically = true;
-                    mainSlider.setValue(rawValue, juce::dontSendNotification);
-                    isSettingValueProgrammatically = false;
+                    setMainSliderValue(rawValue);
                 }
                 
                 double quantizedValue = quantizeValue(rawValue);
                 if (quantizedValue != rawValue) {
                     // Update slider to quantized value without triggering callback
-                    isSettingValueProgrammatically = true;
-                    mainSlider.setValue(quantizedValue, juce::dontSendNotification);
-                    isSettingValueProgrammatically = false;
+                    setMainSliderValue(quantizedValue);
                 }
                 int value = (int)quantizedValue;
+                publishValueToStateStore();
                 // Manual slider change - allow snap on value changes
                 displayManager.setMidiValueWithSnap(value, true);
                 
@@ -245,9 +244,9 @@ public:
             // Set drag state for movement-aware snapping
             displayManager.setDragState(true);
             
-            if (automationEngine.isSliderAutomating(index))
+            if (isAutomating())
             {
-                automationEngine.handleManualOverride(index);
+                automationEngine->handleManualOverride(index);
             }
         };
         
@@ -295,16 +294,16 @@ public:
         // Automation control panel - handles knobs, buttons, visualizer, target input
         addAndMakeVisible(automationControlPanel);
         automationControlPanel.onGoButtonClicked = [this]() {
-            if (automationEngine.isSliderAutomating(index))
+            if (isAutomating())
             {
-                automationEngine.stopAutomation(index);
+                automationEngine->stopAutomation(index);
                 automationControlPanel.updateGoButtonState(false);
                 if (onAutomationToggled) onAutomationToggled(index, false);
             }
             else
             {
                 startAutomation();
-                automationControlPanel.updateGoButtonState(automationEngine.isSliderAutomating(index));
+                automationControlPanel.updateGoButtonState(isAutomating());
                 if (onAutomationToggled) onAutomationToggled(index, true);
             }
         };
@@ -334,9 +333,6 @@ public:
         // Set up display manager callbacks
         setupDisplayManager();
         
-        // Set up automation engine callbacks
-        setupAutomationEngine();
-        
         // Initialize learn zones
         setupLearnZones();
 
@@ -344,7 +340,7 @@ public:
         setupHelperKnobSystem();
 
         // Initialize GO button state based on current automation status
-        automationControlPanel.updateGoButtonState(automationEngine.isSliderAutomating(index));
+        automationControlPanel.updateGoButtonState(isAutomating());
         
         // Register for scale change notifications
         GlobalUIScale::getInstance().addScaleChangeListener(this);
@@ -352,8 +348,8 @@ public:
     
     ~SimpleSliderControl()
     {
-        // CRITICAL: Stop automation and timer before destruction
-        automationEngine.stopAutomation(index);
+        // CRITICAL: Stop timer before destruction
+        // (the shared automation engine is stopped by its owner, which outlives the sliders)
         stopTimer();
 
         // Clean up helper knob system
@@ -487,9 +483,7 @@ public:
     void setValue(double newValue)
     {
         double quantizedValue = quantizeValue(newValue);
-        isSettingValueProgrammatically = true;
-        mainSlider.setValue(quantizedValue, juce::dontSendNotification);
-        isSettingValueProgrammatically = false;
+        setMainSliderValue(quantizedValue);
         
         // Use snap-aware method for external value setting
         displayManager.setMidiValueWithSnap(quantizedValue, true);
@@ -498,6 +492,25 @@ public:
     
     bool isLocked() const { return lockState; }
     
+    // The automation engine shared by all sliders. Its owner forwards the engine's callbacks
+    // for this slider to applyAutomationValue(), handleAutomationStateChanged() and
+    // handleScheduledAutomationOutput().
+    void setAutomationEngine(AutomationEngine* engine) { automationEngine = engine; }
+    bool isAutomating() const { return automationEngine != nullptr && automationEngine->isSliderAutomating(index); }
+    
+    // Shared state the engines read instead of calling back into this component. Every
+    // change of value, lock or automation state is published to it from here on.
+    void setSliderStateStore(SliderStateStore* store)
+    {
+        sliderStateStore = store;
+        if (sliderStateStore != nullptr)
+        {
+            sliderStateStore->setLocked(index, lockState);
+            sliderStateStore->setAutomating(index, isAutomating());
+            publishValueToStateStore();
+        }
+    }
+    
     void setLocked(bool shouldBeLocked)
     {
         if (lockState != shouldBeLocked)
@@ -512,6 +525,9 @@ public:
             // Enable/disable slider interaction
             mainSlider.setInterceptsMouseClicks(!lockState, !lockState);
             
+            if (sliderStateStore != nullptr)
+                sliderStateStore->setLocked(index, lockState);
+            
             // Notify about lock state change
             if (onLockStateChanged) onLockStateChanged(index, lockState);
         }
@@ -527,9 +543,7 @@ public:
         automationControlPanel.setTargetValue(displayManager.getDisplayValue());
         
         // Update the main slider with the preserved MIDI value to maintain position
-        isSettingValueProgrammatically = true;
-        mainSlider.setValue(displayManager.getMidiValue(), juce::dontSendNotification);
-        isSettingValueProgrammatically = false;
+        setMainSliderValue(displayManager.getMidiValue());
         
         // Trigger parent repaint to update visual thumb position
         if (auto* parent = getParentComponent())
@@ -545,9 +559,7 @@ public:
         displayManager.setOrientation(orientation);
         
         // Restore the same MIDI value to maintain logical position
-        isSettingValueProgrammatically = true;
-        mainSlider.setValue(currentMidiValue, juce::dontSendNotification);
-        isSettingValueProgrammatically = false;
+        setMainSliderValue(currentMidiValue);
         
         repaint(); // Force visual update for orientation changes
     }
@@ -561,9 +573,7 @@ public:
         displayManager.setBipolarSettings(settings);
         
         // Restore the same MIDI value to maintain logical position
-        isSettingValueProgrammatically = true;
-        mainSlider.setValue(currentMidiValue, juce::dontSendNotification);
-        isSettingValueProgrammatically = false;
+        setMainSliderValue(currentMidiValue);
         
         repaint(); // Force visual update for bipolar changes
     }
@@ -740,9 +750,7 @@ public:
         displayManager.setKeyboardNavigationMode(true);
         
         double quantizedValue = quantizeValue(newValue);
-        isSettingValueProgrammatically = true;
-        mainSlider.setValue(quantizedValue, juce::dontSendNotification);
-        isSettingValueProgrammatically = false;
+        setMainSliderValue(quantizedValue);
         
         // Use snap-aware method for keyboard input
         displayManager.setMidiValueWithSnap(quantizedValue, true);
@@ -770,9 +778,8 @@ public:
     void setValueFromMIDI(double newValue)
     {
         double quantizedValue = quantizeValue(newValue);
-        isSettingValueProgrammatically = true;
-        mainSlider.setValue(quantizedValue, juce::dontSendNotification);
-        isSettingValueProgrammatically = false;
+        setMainSliderValue(quantizedValue);
+        LatencyTracer::getInstance().markSliderUpdate();
         
         // Use snap-aware method for external MIDI input
         displayManager.setMidiValueWithSnap(quantizedValue, true);
@@ -939,9 +946,7 @@ public:
         bool handled = interactionHandler.handleMouseDrag(event, getVisualTrackBounds().toFloat(),
                                                          mainSlider.getMinimum(), mainSlider.getMaximum(),
                                                          [this](double newValue) {
-            isSettingValueProgrammatically = true;
-            mainSlider.setValue(newValue, juce::dontSendNotification);
-            isSettingValueProgrammatically = false;
+            setMainSliderValue(newValue);
             // Update during manual drag - use drag flag to prevent snapping
             displayManager.setMidiValueWithSnap(newValue, true, true); // isDragUpdate = true
             if (sendMidiCallback)
@@ -988,7 +993,7 @@ public:
         if (lockState) return;
         
         // Don't interfere if automation is currently running
-        if (automationEngine.isSliderAutomating(index)) return;
+        if (isAutomating()) return;
         
         double resetValue;
         SliderOrientation orientation = displayManager.getOrientation();
@@ -1020,9 +1025,7 @@ public:
         resetValue = juce::jlimit(0.0, 16383.0, resetValue);
         
         // Set the value with notification to trigger MIDI output and UI updates
-        isSettingValueProgrammatically = true;
-        mainSlider.setValue(resetValue, juce::sendNotification);
-        isSettingValueProgrammatically = false;
+        setMainSliderValue(resetValue, juce::sendNotification);
         
         // Trigger parent repaint to update visual thumb position
         if (auto* parent = getParentComponent())
@@ -1421,6 +1424,9 @@ public:
     // Automation start/stop callback
     std::function<void(int sliderIndex, bool isStarting)> onAutomationToggled;
     
+    // Pre-scheduled automation output (quantized values with absolute timestamps)
+    std::function<void(int sliderIndex, const std::vector<AutomationEngine::ScheduledPoint>& points)> onScheduleMidiOutput;
+    
     // Time mode change callback
     std::function<void(int sliderIndex, AutomationControlPanel::TimeMode mode)> onTimeModeChanged;
     
@@ -1525,9 +1531,7 @@ private:
         // Set up snap callback for consistent behavior
         displayManager.onSnapToCenter = [this](double snappedMidiValue) {
             // Update slider to snapped value
-            isSettingValueProgrammatically = true;
-            mainSlider.setValue(snappedMidiValue, juce::dontSendNotification);
-            isSettingValueProgrammatically = false;
+            setMainSliderValue(snappedMidiValue);
             
             // Send MIDI output and trigger visual updates
             if (sendMidiCallback)
@@ -1550,9 +1554,8 @@ private:
         // Update main slider from helper knob value (used in Deadzone mode)
         double quantizedValue = quantizeValue(helperValue);
 
-        isSettingValueProgrammatically = true;
-        mainSlider.setValue(quantizedValue, juce::dontSendNotification);
-        isSettingValueProgrammatically = false;
+        setMainSliderValue(quantizedValue);
+        LatencyTracer::getInstance().markSliderUpdate();
 
         // Update display manager with smooth value (no snapping from helper)
         displayManager.setMidiValue(quantizedValue);
@@ -1569,51 +1572,6 @@ private:
         triggerMidiActivity();
     }
 
-    void setupAutomationEngine()
-    {
-        // Set up automation value update callback
-        automationEngine.onValueUpdate = [this](int sliderIndex, double newValue) {
-            if (sliderIndex == index)
-            {
-                double quantizedValue = quantizeValue(newValue);
-                isSettingValueProgrammatically = true;
-                mainSlider.setValue(quantizedValue, juce::dontSendNotification);
-                isSettingValueProgrammatically = false;
-                // Automation should never snap - maintain smooth, precise movement
-                displayManager.setMidiValue(quantizedValue);
-                if (sendMidiCallback)
-                    sendMidiCallback(index, (int)quantizedValue);
-            }
-        };
-        
-        // Set up automation state change callback
-        automationEngine.onAutomationStateChanged = [this](int sliderIndex, bool isAutomating) {
-            if (sliderIndex == index)
-            {
-                // Update GO button state based on automation status
-                automationControlPanel.updateGoButtonState(isAutomating);
-                
-                // Update visualizer state based on automation status
-                auto& visualizer = automationControlPanel.getAutomationVisualizer();
-                if (isAutomating)
-                {
-                    // Pass current knob values for precise animation timing
-                    visualizer.lockCurveForAutomation(
-                        automationControlPanel.getDelayTime(), 
-                        automationControlPanel.getAttackTime(), 
-                        automationControlPanel.getReturnTime()
-                    );
-                }
-                else
-                {
-                    visualizer.unlockCurve();
-                }
-            }
-        };
-        
-        // Animation is now self-contained in the visualizer - no callbacks needed
-    }
-    
     void setupLearnZones()
     {
         // Create learn zones for this slider
@@ -1682,7 +1640,7 @@ private:
     
     void startAutomation()
     {
-        if (automationEngine.isSliderAutomating(index)) return;
+        if (automationEngine == nullptr || isAutomating()) return;
         
         validateTargetValue();
         double targetDisplayValue = automationControlPanel.getTargetValue();
@@ -1692,21 +1650,131 @@ private:
         
         // Set up automation parameters
         AutomationEngine::AutomationParams params;
-        params.delayTime = automationControlPanel.getDelayTime();
-        params.attackTime = automationControlPanel.getAttackTime();
-        params.returnTime = automationControlPanel.getReturnTime();
+        params.isBeatTimed = automationControlPanel.getTimeMode() == TimeMode::Beats;
+        if (params.isBeatTimed)
+        {
+            // Beats run on the engine's beat clock, so the envelope follows tempo changes
+            params.delayTime = automationControlPanel.getDelayBeats();
+            params.attackTime = automationControlPanel.getAttackBeats();
+            params.returnTime = automationControlPanel.getReturnBeats();
+        }
+        else
+        {
+            params.delayTime = automationControlPanel.getDelayTime();
+            params.attackTime = automationControlPanel.getAttackTime();
+            params.returnTime = automationControlPanel.getReturnTime();
+        }
         params.curveValue = automationControlPanel.getCurveValue();
         params.startValue = startMidiValue;
         params.targetValue = targetMidiValue;
+        params.outputGrid = getOutputGrid();
         
         // Start automation through engine
-        automationEngine.startAutomation(index, params);
+        automationEngine->startAutomation(index, params);
         
         // Update GO button state to show "STOP" and highlighting
         automationControlPanel.updateGoButtonState(true);
     }
     
+    // Automation engine callbacks for this slider, forwarded by the engine's owner
+    void applyAutomationValue(double newValue)
+    {
+        double quantizedValue = quantizeValue(newValue);
+        setMainSliderValue(quantizedValue);
+        // Automation should never snap - maintain smooth, precise movement
+        displayManager.setMidiValue(quantizedValue);
+        // Clocked and pre-scheduled automations send their own MIDI output
+        if (automationEngine->isOutputDrivenByEngine(index))
+            triggerMidiActivity();
+        else if (sendMidiCallback)
+            sendMidiCallback(index, (int)quantizedValue);
+    }
+    
+    void handleScheduledAutomationOutput(const std::vector<AutomationEngine::ScheduledPoint>& points)
+    {
+        if (onScheduleMidiOutput)
+        {
+            auto quantizedPoints = points;
+            for (auto& point : quantizedPoints)
+                point.value = quantizeValue(point.value);
+            onScheduleMidiOutput(index, quantizedPoints);
+        }
+    }
+    
+    void handleAutomationStateChanged(bool isAutomationRunning)
+    {
+        if (sliderStateStore != nullptr)
+            sliderStateStore->setAutomating(index, isAutomationRunning);
+        
+        // Update GO button state based on automation status
+        automationControlPanel.updateGoButtonState(isAutomationRunning);
+        
+        // Update visualizer state based on automation status
+        auto& visualizer = automationControlPanel.getAutomationVisualizer();
+        if (isAutomationRunning)
+        {
+            // Pass current knob values for precise animation timing. The visualizer animates
+            // in seconds, so beat-timed knobs go through the engine's beat clock.
+            if (automationControlPanel.getTimeMode() == TimeMode::Beats && automationEngine != nullptr)
+            {
+                double secondsPerBeat = automationEngine->getBeatClock().msPerBeat / 1000.0;
+                visualizer.lockCurveForAutomation(
+                    automationControlPanel.getDelayBeats() * secondsPerBeat,
+                    automationControlPanel.getAttackBeats() * secondsPerBeat,
+                    automationControlPanel.getReturnBeats() * secondsPerBeat
+                );
+            }
+            else
+            {
+                visualizer.lockCurveForAutomation(
+                    automationControlPanel.getDelayTime(), 
+                    automationControlPanel.getAttackTime(), 
+                    automationControlPanel.getReturnTime()
+                );
+            }
+        }
+        else
+        {
+            visualizer.unlockCurve();
+        }
+        
+        // Animation is now self-contained in the visualizer - no callbacks needed
+    }
+    
 private:
+    // Programmatic moves of mainSlider - guarded against the inversion in onValueChange and
+    // published to the state store
+    void setMainSliderValue(double newValue, juce::NotificationType notification = juce::dontSendNotification)
+    {
+        isSettingValueProgrammatically = true;
+        mainSlider.setValue(newValue, notification);
+        isSettingValueProgrammatically = false;
+        publishValueToStateStore();
+    }
+    
+    void publishValueToStateStore()
+    {
+        if (sliderStateStore != nullptr)
+            sliderStateStore->setValue(index, juce::roundToInt(mainSlider.getValue()));
+    }
+    
+    // The slider's quantization as a grid in MIDI units, for output computed off the message
+    // thread; quantizeValue() uses it too. The display mapping is linear with the display
+    // minimum at MIDI 0, so a step in display units is a fixed step in MIDI units from 0.
+    AutomationEngine::OutputGrid getOutputGrid() const
+    {
+        if (is14BitMode && !is14BitMode(index))
+            return { 16383.0 / 127.0, 128.0 };     // 128 discrete 7-bit steps
+        
+        double displayRange = std::abs(displayManager.getDisplayMax() - displayManager.getDisplayMin());
+        if (stepIncrement <= 0.0 || displayRange < 0.001)
+            return {};
+        
+        // Step larger than the range snaps to the closest endpoint
+        double step = stepIncrement >= displayRange ? 16383.0 : stepIncrement * 16383.0 / displayRange;
+        return { step, step };
+    }
+    
     // Quantize value to step increments based on display range
     double quantizeValue(double midiValue) const
     {
@@ -1735,48 +1803,17 @@ private:
         
         if (stepIncrement <= 0.0) return midiValue; // No quantization
         
-        // Convert MIDI value to display value for quantization
-        double displayValue = displayManager.midiToDisplay(midiValue);
-        double displayMin = displayManager.getDisplayMin();
-        double displayMax = displayManager.getDisplayMax();
-        
         // Handle invalid range
-        double displayRange = displayMax - displayMin;
-        if (std::abs(displayRange) < 0.001)
+        if (std::abs(displayManager.getDisplayMax() - displayManager.getDisplayMin()) < 0.001)
         {
             // Range too small - return clamped MIDI value
             return juce::jlimit(0.0, 16383.0, midiValue);
         }
         
-        // Handle edge cases
-        if (stepIncrement >= std::abs(displayRange))
-        {
-            // Step is larger than range - snap to closest endpoint
-            double distToMin = std::abs(displayValue - displayMin);
-            double distToMax = std::abs(displayValue - displayMax);
-            double snapTarget = (distToMin <= distToMax) ? displayMin : displayMax;
-            return displayManager.displayToMidi(snapTarget);
-        }
-        
-        // Calculate number of steps and quantize
-        // Handle both positive and negative ranges
-        double relativeValue = displayValue - displayMin;
-        double stepNumber = std::round(relativeValue / stepIncrement);
-        double quantizedDisplay = displayMin + (stepNumber * stepIncrement);
-        
-        // Clamp to display range (handles both positive and negative ranges)
-        if (displayMin <= displayMax)
-        {
-            quantizedDisplay = juce::jlimit(displayMin, displayMax, quantizedDisplay);
-        }
-        else
-        {
-            quantizedDisplay = juce::jlimit(displayMax, displayMin, quantizedDisplay);
-        }
-        
-        // Convert back to MIDI value and clamp to MIDI range
-        double quantizedMidi = displayManager.displayToMidi(quantizedDisplay);
-        return juce::jlimit(0.0, 16383.0, quantizedMidi);
+        // Steps count from the display minimum, which is MIDI 0. Going through the same grid
+        // as automation output keeps GUI and engine values on the same steps.
+        auto grid = getOutputGrid();
+        return grid.getStepCentre(grid.getStepIndex(midiValue));
     }
 
 public:
@@ -1802,9 +1839,10 @@ public:
     SliderLayoutManager layoutManager;
     
     // Core Systems
-    AutomationEngine automationEngine;
+    AutomationEngine* automationEngine = nullptr;   // Shared, owned by the parent
     SliderDisplayManager displayManager;
     AutomationConfigManager* configManager = nullptr;
+    SliderStateStore* sliderStateStore = nullptr;
     
     // MIDI activity indicator variables
     bool midiActivityState = false;
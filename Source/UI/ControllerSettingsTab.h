@@ -4,6 +4,7 @@
 #include "../CustomLookAndFeel.h"
 #include "../SimpleSliderControl.h"
 #include "../Core/SliderDisplayManager.h"
+#include "../Core/MidiOutputQueue.h"
 #include "GlobalUIScale.h"
 #include "ThemeManager.h"
 
@@ -60,6 +61,16 @@ public:
     }
     bool getCurrentShowAutomation() const { return showAutomationButton.getToggleState(); }
     
+    // NRPN/RPN addressing - ControlChange sends the usual CC pair on the CC number
+    void setParameter(MidiParameterType type, int parameterNumber);
+    MidiParameterType getCurrentParameterType() const { return static_cast<MidiParameterType>(parameterTypeCombo.getSelectedId() - 1); }
+    int getCurrentParameterNumber() const { return parameterNumberInput.getText().getIntValue(); }
+    
+    // Output port routing - one toggle per open port, 0xFFFFFFFF when every toggle is on
+    void setNumOutputPorts(int numPorts);
+    void setOutputRouting(uint32_t portMask);
+    uint32_t getCurrentOutputRouting() const;
+    
     // Callback functions for communication with parent
     std::function<void()> onSettingsChanged;
     std::function<void(int)> onBankSelected;
@@ -95,6 +106,9 @@ private:
     // Section 1 - Core MIDI
     juce::Label ccNumberLabel;
     juce::TextEditor ccNumberInput;
+    juce::Label parameterTypeLabel;
+    juce::ComboBox parameterTypeCombo;
+    juce::TextEditor parameterNumberInput;
     // outputModeLabel removed - no longer needed without 7-bit/14-bit toggle
     
     // Section 2 - Display & Range
@@ -115,6 +129,11 @@ private:
     juce::Label inputModeLabel;
     juce::ToggleButton deadzoneButton, directButton;
     
+    // Output port routing (in Utilities section)
+    juce::Label outputRoutingLabel;
+    juce::OwnedArray<juce::ToggleButton> outputRoutingButtons; // One per possible port
+    static constexpr int MAX_OUTPUT_PORTS = 8; // Matches MidiManager::MAX_OUTPUT_PORTS
+    
     // Section 4 - Visual
     juce::Label colorPickerLabel;
     juce::OwnedArray<juce::TextButton> colorButtons; // 4x2 grid
@@ -180,6 +199,7 @@ private:
     
     // Validation and application methods
     void validateAndApplyCCNumber();
+    void validateAndApplyParameter();
     void validateAndApplyRange();
     void applyIncrements();
     void setAutoStepMode();
@@ -189,6 +209,7 @@ private:
     void applySnapThreshold();
     void applyCustomName();
     void applyAutomationVisibility();
+    void applyOutputRouting();
     void selectColor(int colorId);
     void resetCurrentSlider();
     
@@ -221,6 +242,8 @@ inline ControllerSettingsTab::~ControllerSettingsTab()
     // Clean up custom look and feel
     resetSliderButton.setLookAndFeel(nullptr);
     autoStepButton.setLookAndFeel(nullptr);
+    for (auto* button : outputRoutingButtons)
+        button->setLookAndFeel(nullptr);
 }
 
 inline void ControllerSettingsTab::paint(juce::Graphics& g)
@@ -257,8 +280,8 @@ inline void ControllerSettingsTab::paint(juce::Graphics& g)
 
     bounds.removeFromTop(sectionSpacing); // Spacing between sections
 
-    // Section 2 - Utilities Box (CC Number, Input Behavior, Show Automation)
-    auto utilitiesHeight = headerHeight + (labelHeight + controlSpacing) * 3 + controlSpacing;
+    // Section 2 - Utilities Box (CC Number, Send As, Input Behavior, Show Automation, Output Ports)
+    auto utilitiesHeight = headerHeight + (labelHeight + controlSpacing) * 5 + controlSpacing;
     auto utilitiesBounds = bounds.removeFromTop(utilitiesHeight);
 
     g.setColour(BlueprintColors::sectionBackground());
@@ -491,6 +514,36 @@ inline void ControllerSettingsTab::setupPerSliderControls()
 
     // outputModeLabel setup removed - no longer needed
 
+    // NRPN/RPN controls (in Utilities section)
+    addAndMakeVisible(parameterTypeLabel);
+    parameterTypeLabel.setText("Send As:", juce::dontSendNotification);
+    parameterTypeLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    parameterTypeLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+
+    addAndMakeVisible(parameterTypeCombo);
+    parameterTypeCombo.addItem("CC Pair", static_cast<int>(MidiParameterType::ControlChange) + 1);
+    parameterTypeCombo.addItem("NRPN", static_cast<int>(MidiParameterType::Nrpn) + 1);
+    parameterTypeCombo.addItem("RPN", static_cast<int>(MidiParameterType::Rpn) + 1);
+    parameterTypeCombo.setSelectedId(1, juce::dontSendNotification);
+    parameterTypeCombo.setColour(juce::ComboBox::backgroundColourId, BlueprintColors::inputBackground());
+    parameterTypeCombo.setColour(juce::ComboBox::textColourId, BlueprintColors::textPrimary());
+    parameterTypeCombo.setColour(juce::ComboBox::outlineColourId, BlueprintColors::blueprintLines());
+    parameterTypeCombo.onChange = [this]() {
+        validateAndApplyParameter();
+        if (onRequestFocus) onRequestFocus();
+    };
+
+    addChildComponent(parameterNumberInput);
+    parameterNumberInput.setInputRestrictions(5, "0123456789");
+    parameterNumberInput.setTooltip("NRPN/RPN parameter number (0-16383)");
+    parameterNumberInput.setColour(juce::TextEditor::backgroundColourId, BlueprintColors::inputBackground());
+    parameterNumberInput.setColour(juce::TextEditor::textColourId, BlueprintColors::textPrimary());
+    parameterNumberInput.setColour(juce::TextEditor::outlineColourId, BlueprintColors::blueprintLines());
+    parameterNumberInput.onReturnKey = [this]() { parameterNumberInput.moveKeyboardFocusToSibling(true); };
+    parameterNumberInput.onFocusLost = [this]() { validateAndApplyParameter(); };
+    // Set font after all other properties are configured
+    parameterNumberInput.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+
 
     // Input Behavior controls (in Utilities section)
     addAndMakeVisible(inputModeLabel);
@@ -638,6 +691,24 @@ inline void ControllerSettingsTab::setupPerSliderControls()
         if (onRequestFocus) onRequestFocus();
     };
     
+    // Output port routing controls
+    addAndMakeVisible(outputRoutingLabel);
+    outputRoutingLabel.setText("Output Ports:", juce::dontSendNotification);
+    outputRoutingLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    outputRoutingLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+    
+    for (int i = 0; i < MAX_OUTPUT_PORTS; ++i)
+    {
+        auto* routingButton = new juce::ToggleButton(juce::String(i + 1));
+        outputRoutingButtons.add(routingButton);
+        addChildComponent(routingButton);
+        routingButton->setLookAndFeel(&customButtonLookAndFeel);
+        routingButton->setToggleState(true, juce::dontSendNotification); // Default to all ports
+        routingButton->setTooltip("Send this slider to output port " + juce::String(i + 1));
+        routingButton->onClick = [this]() { applyOutputRouting(); if (onRequestFocus) onRequestFocus(); };
+    }
+    setNumOutputPorts(1);
+    
     // Color controls (moved to Display & Range section)
     addAndMakeVisible(colorPickerLabel);
     colorPickerLabel.setText("Color:", juce::dontSendNotification);
@@ -763,8 +834,8 @@ inline void ControllerSettingsTab::layoutPerSliderSections(juce::Rectangle<int>&
 
     bounds.removeFromTop(sectionSpacing); // Spacing between sections
 
-    // Section 2 - Utilities (CC Number, Input Behavior, Show Automation)
-    auto utilitiesHeight = headerHeight + (labelHeight + controlSpacing) * 3 + controlSpacing;
+    // Section 2 - Utilities (CC Number, Send As, Input Behavior, Show Automation, Output Ports)
+    auto utilitiesHeight = headerHeight + (labelHeight + controlSpacing) * 5 + controlSpacing;
     auto utilitiesBounds = bounds.removeFromTop(utilitiesHeight);
 
     utilitiesHeader.setBounds(utilitiesBounds.removeFromTop(headerHeight));
@@ -778,6 +849,16 @@ inline void ControllerSettingsTab::layoutPerSliderSections(juce::Rectangle<int>&
 
     utilitiesBounds.removeFromTop(controlSpacing);
 
+    // Send As row (parameter number only for NRPN/RPN)
+    auto parameterRow = utilitiesBounds.removeFromTop(labelHeight);
+    parameterTypeLabel.setBounds(parameterRow.removeFromLeft(scale.getScaled(120)));
+    parameterRow.removeFromLeft(scale.getScaled(8));
+    parameterTypeCombo.setBounds(parameterRow.removeFromLeft(scale.getScaled(80)));
+    parameterRow.removeFromLeft(scale.getScaled(8));
+    parameterNumberInput.setBounds(parameterRow.removeFromLeft(scale.getScaled(60)));
+
+    utilitiesBounds.removeFromTop(controlSpacing);
+
     // Input Behavior row
     auto inputModeRow = utilitiesBounds.removeFromTop(labelHeight);
     inputModeLabel.setBounds(inputModeRow.removeFromLeft(scale.getScaled(120)));
@@ -794,6 +875,18 @@ inline void ControllerSettingsTab::layoutPerSliderSections(juce::Rectangle<int>&
     automationRow.removeFromLeft(scale.getScaled(8));
     showAutomationButton.setBounds(automationRow.removeFromLeft(scale.getScaled(100)));
 
+    utilitiesBounds.removeFromTop(controlSpacing);
+
+    // Output Ports row
+    auto routingRow = utilitiesBounds.removeFromTop(labelHeight);
+    outputRoutingLabel.setBounds(routingRow.removeFromLeft(scale.getScaled(120)));
+    routingRow.removeFromLeft(scale.getScaled(8));
+    for (auto* button : outputRoutingButtons)
+    {
+        button->setBounds(routingRow.removeFromLeft(scale.getScaled(20)));
+        routingRow.removeFromLeft(scale.getScaled(2));
+    }
+
     // Reset button at bottom with distinguishing space above it
     resetSliderButton.setBounds(resetButtonArea.reduced(scale.getScaled(20), scale.getScaled(2))); // Center with padding
 }
@@ -943,6 +1036,25 @@ inline void ControllerSettingsTab::validateAndApplyCCNumber()
         onSliderSettingChanged(selectedSlider);
 }
 
+inline void ControllerSettingsTab::validateAndApplyParameter()
+{
+    int parameterNumber = juce::jlimit(0, 16383, parameterNumberInput.getText().getIntValue());
+    parameterNumberInput.setText(juce::String(parameterNumber), juce::dontSendNotification);
+    
+    // The CC number is still used for plain CC pairs - the parameter number only for NRPN/RPN
+    parameterNumberInput.setVisible(getCurrentParameterType() != MidiParameterType::ControlChange);
+    
+    if (onSliderSettingChanged)
+        onSliderSettingChanged(selectedSlider);
+}
+
+inline void ControllerSettingsTab::setParameter(MidiParameterType type, int parameterNumber)
+{
+    parameterTypeCombo.setSelectedId(static_cast<int>(type) + 1, juce::dontSendNotification);
+    parameterNumberInput.setText(juce::String(juce::jlimit(0, 16383, parameterNumber)), juce::dontSendNotification);
+    parameterNumberInput.setVisible(type != MidiParameterType::ControlChange);
+}
+
 // applyOutputMode method removed - no longer needed as system always uses 14-bit output
 
 inline void ControllerSettingsTab::validateAndApplyRange()
@@ -1132,6 +1244,10 @@ inline void ControllerSettingsTab::resetCurrentSlider()
     // Reset Show Automation to default (true)
     showAutomationButton.setToggleState(true, juce::dontSendNotification);
     
+    // Reset output routing to all ports and addressing to a plain CC pair
+    setOutputRouting(0xFFFFFFFF);
+    setParameter(MidiParameterType::ControlChange, 0);
+    
     if (onSliderSettingChanged)
         onSliderSettingChanged(selectedSlider);
 }
@@ -1316,6 +1432,39 @@ inline void ControllerSettingsTab::applyAutomationVisibility()
         onSliderSettingChanged(selectedSlider);
 }
 
+inline void ControllerSettingsTab::applyOutputRouting()
+{
+    // Notify parent window of the routing change
+    if (onSliderSettingChanged)
+        onSliderSettingChanged(selectedSlider);
+}
+
+inline void ControllerSettingsTab::setNumOutputPorts(int numPorts)
+{
+    // Hidden toggles keep their state, so a routing mask round-trips through the controls unchanged
+    for (int i = 0; i < outputRoutingButtons.size(); ++i)
+        outputRoutingButtons[i]->setVisible(i < numPorts);
+}
+
+inline void ControllerSettingsTab::setOutputRouting(uint32_t portMask)
+{
+    for (int i = 0; i < outputRoutingButtons.size(); ++i)
+        outputRoutingButtons[i]->setToggleState((portMask & (1u << i)) != 0, juce::dontSendNotification);
+}
+
+inline uint32_t ControllerSettingsTab::getCurrentOutputRouting() const
+{
+    uint32_t portMask = 0;
+    for (int i = 0; i < outputRoutingButtons.size(); ++i)
+    {
+        if (outputRoutingButtons[i]->getToggleState())
+            portMask |= 1u << i;
+    }
+    
+    // Every toggle on means every port, including ones added later
+    return portMask == (1u << MAX_OUTPUT_PORTS) - 1 ? 0xFFFFFFFF : portMask;
+}
+
 inline void ControllerSettingsTab::scaleFactorChanged(float newScale)
 {
     // Update fonts for all labels and buttons
@@ -1329,6 +1478,7 @@ inline void ControllerSettingsTab::scaleFactorChanged(float newScale)
     displayHeader.setFont(GlobalUIScale::getInstance().getScaledFont(14.0f).boldened());
     utilitiesHeader.setFont(GlobalUIScale::getInstance().getScaledFont(14.0f).boldened());
     ccNumberLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    parameterTypeLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     inputModeLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     rangeLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     rangeDashLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
@@ -1336,11 +1486,13 @@ inline void ControllerSettingsTab::scaleFactorChanged(float newScale)
     orientationLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     snapLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     automationVisibilityLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    outputRoutingLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     colorPickerLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     
     // Update fonts for input boxes
     nameInput.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     ccNumberInput.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    parameterNumberInput.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     rangeMinInput.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     rangeMaxInput.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     incrementsInput.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
@@ -1349,18 +1501,21 @@ inline void ControllerSettingsTab::scaleFactorChanged(float newScale)
     // Store current text, clear, and reset to force font refresh
     auto nameText = nameInput.getText();
     auto ccText = ccNumberInput.getText();
+    auto parameterText = parameterNumberInput.getText();
     auto minText = rangeMinInput.getText();
     auto maxText = rangeMaxInput.getText();
     auto incText = incrementsInput.getText();
     
     nameInput.clear();
     ccNumberInput.clear();
+    parameterNumberInput.clear();
     rangeMinInput.clear();
     rangeMaxInput.clear();
     incrementsInput.clear();
     
     nameInput.setText(nameText, false);
     ccNumberInput.setText(ccText, false);
+    parameterNumberInput.setText(parameterText, false);
     rangeMinInput.setText(minText, false);
     rangeMaxInput.setText(maxText, false);
     incrementsInput.setText(incText, false);
@@ -1379,6 +1534,7 @@ inline void ControllerSettingsTab::themeChanged(ThemeManager::ThemeType newTheme
     displayHeader.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
     utilitiesHeader.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
     ccNumberLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+    parameterTypeLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
     inputModeLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
     rangeLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
     rangeDashLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
@@ -1386,6 +1542,7 @@ inline void ControllerSettingsTab::themeChanged(ThemeManager::ThemeType newTheme
     orientationLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
     snapLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
     automationVisibilityLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+    outputRoutingLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
     colorPickerLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
 
     // Update bank selector colors (preserve selected/inactive states via updateBankSelectorAppearance)
@@ -1403,6 +1560,10 @@ inline void ControllerSettingsTab::themeChanged(ThemeManager::ThemeType newTheme
     ccNumberInput.setColour(juce::TextEditor::textColourId, BlueprintColors::textPrimary());
     ccNumberInput.setColour(juce::TextEditor::outlineColourId, BlueprintColors::blueprintLines());
 
+    parameterNumberInput.setColour(juce::TextEditor::backgroundColourId, BlueprintColors::inputBackground());
+    parameterNumberInput.setColour(juce::TextEditor::textColourId, BlueprintColors::textPrimary());
+    parameterNumberInput.setColour(juce::TextEditor::outlineColourId, BlueprintColors::blueprintLines());
+
     rangeMinInput.setColour(juce::TextEditor::backgroundColourId, BlueprintColors::inputBackground());
     rangeMinInput.setColour(juce::TextEditor::textColourId, BlueprintColors::textPrimary());
     rangeMinInput.setColour(juce::TextEditor::outlineColourId, BlueprintColors::blueprintLines());
@@ -1420,6 +1581,10 @@ inline void ControllerSettingsTab::themeChanged(ThemeManager::ThemeType newTheme
     orientationCombo.setColour(juce::ComboBox::textColourId, BlueprintColors::textPrimary());
     orientationCombo.setColour(juce::ComboBox::outlineColourId, BlueprintColors::blueprintLines());
 
+    parameterTypeCombo.setColour(juce::ComboBox::backgroundColourId, BlueprintColors::inputBackground());
+    parameterTypeCombo.setColour(juce::ComboBox::textColourId, BlueprintColors::textPrimary());
+    parameterTypeCombo.setColour(juce::ComboBox::outlineColourId, BlueprintColors::blueprintLines());
+
     // Repaint to apply new theme
     repaint();
 }
@@ -1,4 +1,4 @@
-// GlobalSettingsTab.h - Global MIDI Channel and BPM Settings Tab
+// GlobalSettingsTab.h - Global MIDI Channel, BPM and MIDI Output Settings Tab
 #pragma once
 #include <JuceHeader.h>
 #include "../CustomLookAndFeel.h"
@@ -60,14 +60,26 @@ public:
     juce::String getThemeName() const;
     void setTheme(const juce::String& themeName);
 
+    // MIDI output ports - listed here, opened and closed by the owner of the MidiManager
+    void setOutputPorts(const juce::StringArray& portNames);
+    void refreshOutputDevices();
+    void setMidi2OutputAvailable(bool isAvailable); // Whether any open port carries MIDI 2.0
+
     
     // Callback functions for communication with parent
     std::function<void()> onSettingsChanged;
     std::function<void(double)> onBPMChanged;
     std::function<void()> onRequestFocus; // Callback to request focus restoration
+    std::function<void(const juce::String&)> onOutputDeviceAdded; // Device identifier
+    std::function<void()> onVirtualOutputAdded;
+    std::function<void(const juce::String&)> onUmpOutputAdded; // Device identifier
+    std::function<void(int)> onOutputPortRemoved; // Port index
+    std::function<void(bool)> onUmpOutputModeChanged;
+    std::function<void(bool)> onAutomationOutputModeChanged; // true = pre-scheduled
     
 private:
     SettingsWindow* parentWindow;
+    CustomButtonLookAndFeel customButtonLookAndFeel;
     
     // Section header
     juce::Label globalHeader;
@@ -95,8 +107,23 @@ private:
     juce::Label themeLabel;
     juce::ComboBox themeCombo;
 
+    // MIDI output controls
+    juce::Label outputHeader;
+    juce::Label outputPortsLabel;
+    juce::ComboBox outputPortsCombo;
+    juce::TextButton removeOutputButton;
+    juce::Label addOutputLabel;
+    juce::ComboBox outputDeviceCombo;
+    juce::TextButton addOutputButton, addVirtualOutputButton, addUmpOutputButton;
+    juce::Array<juce::MidiDeviceInfo> availableOutputDevices;
+    juce::Label umpOutputLabel;
+    juce::ToggleButton umpOutputToggle;
+    juce::Label automationOutputLabel;
+    juce::ComboBox automationOutputCombo;
+
     // Private methods
     void setupGlobalControls();
+    void setupOutputControls();
     void updateScaleComboOptions();
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GlobalSettingsTab)
@@ -108,6 +135,7 @@ inline GlobalSettingsTab::GlobalSettingsTab(SettingsWindow* parent)
     : parentWindow(parent)
 {
     setupGlobalControls();
+    setupOutputControls();
 
     // Enable keyboard focus for tab
     setWantsKeyboardFocus(true);
@@ -126,6 +154,12 @@ inline GlobalSettingsTab::~GlobalSettingsTab()
 
     // Remove theme change listener
     ThemeManager::getInstance().removeThemeChangeListener(this);
+
+    // Clean up custom look and feel
+    removeOutputButton.setLookAndFeel(nullptr);
+    addOutputButton.setLookAndFeel(nullptr);
+    addVirtualOutputButton.setLookAndFeel(nullptr);
+    addUmpOutputButton.setLookAndFeel(nullptr);
 }
 
 inline void GlobalSettingsTab::paint(juce::Graphics& g)
@@ -165,6 +199,18 @@ inline void GlobalSettingsTab::paint(juce::Graphics& g)
     g.fillRoundedRectangle(section2Bounds.toFloat(), scale.getScaled(4.0f));
     g.setColour(BlueprintColors::blueprintLines().withAlpha(0.6f));
     g.drawRoundedRectangle(section2Bounds.toFloat(), scale.getScaled(4.0f), scale.getScaledLineThickness());
+
+    bounds.removeFromTop(sectionSpacing);
+
+    // MIDI Output section box (Ports + Add + MIDI 2.0 + Automation)
+    const auto section3Height = headerHeight + (labelHeight + controlSpacing) * 4 + controlSpacing;
+    auto section3Bounds = bounds.removeFromTop(section3Height);
+    section3Bounds = section3Bounds.expanded(scale.getScaled(8), scale.getScaled(4));
+
+    g.setColour(BlueprintColors::sectionBackground());
+    g.fillRoundedRectangle(section3Bounds.toFloat(), scale.getScaled(4.0f));
+    g.setColour(BlueprintColors::blueprintLines().withAlpha(0.6f));
+    g.drawRoundedRectangle(section3Bounds.toFloat(), scale.getScaled(4.0f), scale.getScaledLineThickness());
 }
 
 inline void GlobalSettingsTab::resized()
@@ -228,6 +274,53 @@ inline void GlobalSettingsTab::resized()
     alwaysOnTopLabel.setBounds(alwaysOnTopRow.removeFromLeft(scale.getScaled(100)));
     alwaysOnTopRow.removeFromLeft(scale.getScaled(8));
     alwaysOnTopToggle.setBounds(alwaysOnTopRow.removeFromLeft(scale.getScaled(80)));
+
+    // The appearance box is painted one header row taller than its controls
+    bounds.removeFromTop(headerHeight + controlSpacing + sectionSpacing);
+
+    // MIDI Output section
+    auto outputBounds = bounds.removeFromTop(headerHeight + (labelHeight + controlSpacing) * 4 + controlSpacing);
+
+    outputHeader.setBounds(outputBounds.removeFromTop(headerHeight));
+    outputBounds.removeFromTop(controlSpacing);
+
+    // Open ports row
+    auto portsRow = outputBounds.removeFromTop(labelHeight);
+    outputPortsLabel.setBounds(portsRow.removeFromLeft(scale.getScaled(60)));
+    portsRow.removeFromLeft(scale.getScaled(8));
+    removeOutputButton.setBounds(portsRow.removeFromRight(scale.getScaled(60)));
+    portsRow.removeFromRight(scale.getScaled(4));
+    outputPortsCombo.setBounds(portsRow);
+
+    outputBounds.removeFromTop(controlSpacing);
+
+    // Add port row
+    auto addRow = outputBounds.removeFromTop(labelHeight);
+    addOutputLabel.setBounds(addRow.removeFromLeft(scale.getScaled(60)));
+    addRow.removeFromLeft(scale.getScaled(8));
+    addVirtualOutputButton.setBounds(addRow.removeFromRight(scale.getScaled(60)));
+    addRow.removeFromRight(scale.getScaled(4));
+    addUmpOutputButton.setBounds(addRow.removeFromRight(scale.getScaled(40)));
+    addRow.removeFromRight(scale.getScaled(4));
+    addOutputButton.setBounds(addRow.removeFromRight(scale.getScaled(40)));
+    addRow.removeFromRight(scale.getScaled(4));
+    outputDeviceCombo.setBounds(addRow);
+
+    outputBounds.removeFromTop(controlSpacing);
+
+    // MIDI 2.0 row
+    auto umpRow = outputBounds.removeFromTop(labelHeight);
+    umpOutputLabel.setBounds(umpRow.removeFromLeft(scale.getScaled(80)));
+    umpRow.removeFromLeft(scale.getScaled(8));
+    umpOutputToggle.setBounds(umpRow.removeFromLeft(scale.getScaled(220)));
+
+    outputBounds.removeFromTop(controlSpacing);
+
+    // Automation output row
+    auto automationRow = outputBounds.removeFromTop(labelHeight);
+    automationOutputLabel.setBounds(automationRow.removeFromLeft(scale.getScaled(80)));
+    automationRow.removeFromLeft(scale.getScaled(8));
+    automationOutputCombo.setBounds(automationRow.removeFromLeft(scale.getScaled(160)));
 }
 
 inline bool GlobalSettingsTab::keyPressed(const juce::KeyPress& key)
@@ -435,6 +528,168 @@ inline void GlobalSettingsTab::setupGlobalControls()
 
 }
 
+inline void GlobalSettingsTab::setupOutputControls()
+{
+    // Section header
+    addAndMakeVisible(outputHeader);
+    outputHeader.setText("MIDI Output", juce::dontSendNotification);
+    outputHeader.setFont(GlobalUIScale::getInstance().getScaledFont(14.0f).boldened());
+    outputHeader.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+
+    // Open ports - sliders pick from these in the Controller tab
+    addAndMakeVisible(outputPortsLabel);
+    outputPortsLabel.setText("Ports:", juce::dontSendNotification);
+    outputPortsLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    outputPortsLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+
+    addAndMakeVisible(outputPortsCombo);
+    outputPortsCombo.setTextWhenNothingSelected("No output ports");
+    outputPortsCombo.setColour(juce::ComboBox::backgroundColourId, BlueprintColors::inputBackground());
+    outputPortsCombo.setColour(juce::ComboBox::textColourId, BlueprintColors::textPrimary());
+    outputPortsCombo.setColour(juce::ComboBox::outlineColourId, BlueprintColors::blueprintLines());
+    outputPortsCombo.onChange = [this]() {
+        if (onRequestFocus) onRequestFocus();
+    };
+
+    addAndMakeVisible(removeOutputButton);
+    removeOutputButton.setButtonText("Remove");
+    removeOutputButton.setLookAndFeel(&customButtonLookAndFeel);
+    removeOutputButton.onClick = [this]() {
+        int portIndex = outputPortsCombo.getSelectedItemIndex();
+        if (portIndex >= 0 && onOutputPortRemoved)
+            onOutputPortRemoved(portIndex);
+        if (onRequestFocus) onRequestFocus();
+    };
+
+    // Add a hardware port or a virtual one
+    addAndMakeVisible(addOutputLabel);
+    addOutputLabel.setText("Add:", juce::dontSendNotification);
+    addOutputLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    addOutputLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+
+    addAndMakeVisible(outputDeviceCombo);
+    outputDeviceCombo.setTextWhenNothingSelected("Select MIDI Output Device...");
+    outputDeviceCombo.setColour(juce::ComboBox::backgroundColourId, BlueprintColors::inputBackground());
+    outputDeviceCombo.setColour(juce::ComboBox::textColourId, BlueprintColors::textPrimary());
+    outputDeviceCombo.setColour(juce::ComboBox::outlineColourId, BlueprintColors::blueprintLines());
+    outputDeviceCombo.onChange = [this]() {
+        if (onRequestFocus) onRequestFocus();
+    };
+    refreshOutputDevices();
+
+    addAndMakeVisible(addOutputButton);
+    addOutputButton.setButtonText("Add");
+    addOutputButton.setLookAndFeel(&customButtonLookAndFeel);
+    addOutputButton.onClick = [this]() {
+        int deviceIndex = outputDeviceCombo.getSelectedItemIndex();
+        if (juce::isPositiveAndBelow(deviceIndex, availableOutputDevices.size()) && onOutputDeviceAdded)
+            onOutputDeviceAdded(availableOutputDevices[deviceIndex].identifier);
+        if (onRequestFocus) onRequestFocus();
+    };
+
+    addAndMakeVisible(addVirtualOutputButton);
+    addVirtualOutputButton.setButtonText("Virtual");
+    addVirtualOutputButton.setLookAndFeel(&customButtonLookAndFeel);
+    addVirtualOutputButton.onClick = [this]() {
+        if (onVirtualOutputAdded)
+            onVirtualOutputAdded();
+        if (onRequestFocus) onRequestFocus();
+    };
+
+    // The selected device as a UMP endpoint - MIDI 2.0 packets are downconverted on the way out
+    addAndMakeVisible(addUmpOutputButton);
+    addUmpOutputButton.setButtonText("UMP");
+    addUmpOutputButton.setLookAndFeel(&customButtonLookAndFeel);
+    addUmpOutputButton.setTooltip("Add the selected device as a UMP port");
+    addUmpOutputButton.onClick = [this]() {
+        int deviceIndex = outputDeviceCombo.getSelectedItemIndex();
+        if (juce::isPositiveAndBelow(deviceIndex, availableOutputDevices.size()) && onUmpOutputAdded)
+            onUmpOutputAdded(availableOutputDevices[deviceIndex].identifier);
+        if (onRequestFocus) onRequestFocus();
+    };
+
+    // MIDI 2.0 mode for UMP ports
+    addAndMakeVisible(umpOutputLabel);
+    umpOutputLabel.setText("MIDI 2.0:", juce::dontSendNotification);
+    umpOutputLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    umpOutputLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+
+    addAndMakeVisible(umpOutputToggle);
+    umpOutputToggle.setButtonText("One packet per update on UMP ports");
+    umpOutputToggle.setToggleState(false, juce::dontSendNotification);
+    umpOutputToggle.setColour(juce::ToggleButton::textColourId, BlueprintColors::textPrimary());
+    umpOutputToggle.setColour(juce::ToggleButton::tickColourId, BlueprintColors::active());
+    umpOutputToggle.setColour(juce::ToggleButton::tickDisabledColourId, BlueprintColors::textSecondary());
+    setMidi2OutputAvailable(false);
+    umpOutputToggle.onClick = [this]() {
+        if (onUmpOutputModeChanged)
+            onUmpOutputModeChanged(umpOutputToggle.getToggleState());
+        if (onRequestFocus) onRequestFocus();
+    };
+
+    // Automation output - the engine's high-resolution clock, or points pre-scheduled on the ports
+    addAndMakeVisible(automationOutputLabel);
+    automationOutputLabel.setText("Automation:", juce::dontSendNotification);
+    automationOutputLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    automationOutputLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+
+    addAndMakeVisible(automationOutputCombo);
+    automationOutputCombo.addItem("Clocked", 1);
+    automationOutputCombo.addItem("Pre-scheduled", 2);
+    automationOutputCombo.setSelectedId(1, juce::dontSendNotification);
+    automationOutputCombo.setTooltip("Applies to automations started after the change");
+    automationOutputCombo.setColour(juce::ComboBox::backgroundColourId, BlueprintColors::inputBackground());
+    automationOutputCombo.setColour(juce::ComboBox::textColourId, BlueprintColors::textPrimary());
+    automationOutputCombo.setColour(juce::ComboBox::outlineColourId, BlueprintColors::blueprintLines());
+    automationOutputCombo.onChange = [this]() {
+        if (onAutomationOutputModeChanged)
+            onAutomationOutputModeChanged(automationOutputCombo.getSelectedId() == 2);
+        if (onRequestFocus) onRequestFocus();
+    };
+}
+
+inline void GlobalSettingsTab::setOutputPorts(const juce::StringArray& portNames)
+{
+    int selectedIndex = outputPortsCombo.getSelectedItemIndex();
+
+    outputPortsCombo.clear(juce::dontSendNotification);
+    for (int i = 0; i < portNames.size(); ++i)
+        outputPortsCombo.addItem(juce::String(i + 1) + ": " + portNames[i], i + 1);
+
+    if (!portNames.isEmpty())
+        outputPortsCombo.setSelectedItemIndex(juce::jlimit(0, portNames.size() - 1, selectedIndex), juce::dontSendNotification);
+
+    removeOutputButton.setEnabled(!portNames.isEmpty());
+
+    // Devices may have appeared or disappeared since the list was built
+    refreshOutputDevices();
+}
+
+inline void GlobalSettingsTab::setMidi2OutputAvailable(bool isAvailable)
+{
+    // UMP ports opened on MIDI 1.0 devices always get MSB/LSB pairs, so the mode has nothing to change
+    umpOutputToggle.setEnabled(isAvailable);
+    umpOutputToggle.setTooltip(isAvailable ? juce::String()
+                                           : "Needs a port that carries MIDI 2.0 - UMP ports on MIDI 1.0 devices send MSB/LSB pairs");
+}
+
+inline void GlobalSettingsTab::refreshOutputDevices()
+{
+    auto selectedIdentifier = juce::isPositiveAndBelow(outputDeviceCombo.getSelectedItemIndex(), availableOutputDevices.size())
+                                  ? availableOutputDevices[outputDeviceCombo.getSelectedItemIndex()].identifier
+                                  : juce::String();
+
+    availableOutputDevices = juce::MidiOutput::getAvailableDevices();
+
+    outputDeviceCombo.clear(juce::dontSendNotification);
+    for (int i = 0; i < availableOutputDevices.size(); ++i)
+    {
+        outputDeviceCombo.addItem(availableOutputDevices[i].name, i + 1);
+        if (availableOutputDevices[i].identifier == selectedIdentifier)
+            outputDeviceCombo.setSelectedItemIndex(i, juce::dontSendNotification);
+    }
+}
+
 inline void GlobalSettingsTab::setSyncStatus(bool isExternal, double externalBPM)
 {
     if (isExternal && externalBPM > 0.0)
@@ -545,6 +800,11 @@ inline void GlobalSettingsTab::scaleFactorChanged(float newScale)
     themeLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     uiScaleLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
     alwaysOnTopLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    outputHeader.setFont(GlobalUIScale::getInstance().getScaledFont(14.0f).boldened());
+    outputPortsLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    addOutputLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    umpOutputLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
+    automationOutputLabel.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
 
     // Update BPM TextEditor font and force refresh
     bpmInput.setFont(GlobalUIScale::getInstance().getScaledFont(12.0f));
@@ -570,6 +830,12 @@ inline void GlobalSettingsTab::themeChanged(ThemeManager::ThemeType newTheme, co
     uiScaleLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
     alwaysOnTopLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
     themeLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+    outputHeader.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+    outputPortsLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+    addOutputLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+    umpOutputLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
+    umpOutputToggle.setColour(juce::ToggleButton::textColourId, BlueprintColors::textPrimary());
+    automationOutputLabel.setColour(juce::Label::textColourId, BlueprintColors::textPrimary());
 
     // Update sync status label (preserve sync-specific color logic)
     if (syncStatusLabel.getText().contains("External"))
@@ -590,6 +856,13 @@ inline void GlobalSettingsTab::themeChanged(ThemeManager::ThemeType newTheme, co
     themeCombo.setColour(juce::ComboBox::textColourId, BlueprintColors::textPrimary());
     themeCombo.setColour(juce::ComboBox::outlineColourId, BlueprintColors::blueprintLines());
 
+    for (auto* combo : { &outputPortsCombo, &outputDeviceCombo, &automationOutputCombo })
+    {
+        combo->setColour(juce::ComboBox::backgroundColourId, BlueprintColors::inputBackground());
+        combo->setColour(juce::ComboBox::textColourId, BlueprintColors::textPrimary());
+        combo->setColour(juce::ComboBox::outlineColourId, BlueprintColors::blueprintLines());
+    }
+
     // Update BPM slider and input colors
     bpmSlider.setColour(juce::Slider::backgroundColourId, BlueprintColors::inputBackground());
     bpmSlider.setColour(juce::Slider::trackColourId, BlueprintColors::blueprintLines());
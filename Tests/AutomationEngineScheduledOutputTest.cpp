@@ -0,0 +1,141 @@
+#include <JuceHeader.h>
+#include "../Source/Core/AutomationEngine.h"
+#include "../Source/Core/MidiManager.h"
+
+//==============================================================================
+/**
+ * With the output clock off (the "Pre-scheduled" automation output setting) a started
+ * automation hands its lookahead window to onScheduleOutput at once, and MidiManager
+ * queues every point on the port with its own timestamp.
+ */
+class AutomationEngineScheduledOutputTest : public juce::UnitTest
+{
+public:
+    AutomationEngineScheduledOutputTest() : juce::UnitTest("AutomationEngine scheduled output", "AutomationEngine") {}
+
+    void runTest() override
+    {
+        testEngineSchedulesPoints();
+        testClockedEngineDoesNotSchedule();
+        testPointsReachThePort();
+    }
+
+private:
+    struct RecordingUmpOutput : public MidiUmpOutput
+    {
+        juce::String getName() const override { return "Recording UMP Output"; }
+        void sendPacket(const uint32_t*, int, double timeMs) override { packetTimes.push_back(timeMs); }
+
+        std::vector<double> packetTimes;
+    };
+
+    static constexpr double ATTACK_SECONDS = 0.05;    // Inside one lookahead window
+    static constexpr double MIN_POINT_SPACING_MS = 2.0; // AutomationEngine::SCHEDULE_STEP_MS
+
+    static AutomationEngine::AutomationParams makeRamp()
+    {
+        AutomationEngine::AutomationParams params;
+        params.attackTime = ATTACK_SECONDS;
+        params.startValue = 0.0;
+        params.targetValue = 16383.0;
+        return params;
+    }
+
+    void testEngineSchedulesPoints()
+    {
+        beginTest("Pre-scheduled automation renders timestamped points");
+
+        AutomationEngine engine;
+        std::vector<AutomationEngine::ScheduledPoint> points;
+        int clockedValues = 0;
+        int cancellations = 0;
+
+        // Wired like the app, so only the rate decides the output mode
+        engine.onClockedOutput = [&](int, int) { ++clockedValues; };
+        engine.onScheduleOutput = [&](int sliderIndex, const std::vector<AutomationEngine::ScheduledPoint>& block) {
+            expectEquals(sliderIndex, 3);
+            points.insert(points.end(), block.begin(), block.end());
+        };
+        engine.onScheduledOutputCancelled = [&](int) { ++cancellations; };
+        engine.setOutputClockRate(0);
+
+        double before = juce::Time::getMillisecondCounterHiRes();
+        engine.startAutomation(3, makeRamp());
+        double after = juce::Time::getMillisecondCounterHiRes();
+
+        expect(engine.isOutputDrivenByEngine(3));
+        expect(!points.empty(), "The first window is scheduled when the automation starts");
+
+        // Points are spaced out, except the final value which lands exactly at the end
+        for (size_t i = 1; i < points.size(); ++i)
+        {
+            expect(points[i].timeMs > points[i - 1].timeMs);
+            expect(points[i].value >= points[i - 1].value);
+            if (i + 1 < points.size())
+                expect(points[i].timeMs - points[i - 1].timeMs >= MIN_POINT_SPACING_MS - 1.0e-6);
+        }
+
+        if (!points.empty())
+        {
+            expect(points.front().timeMs >= before);
+            expectEquals(points.back().value, 16383.0);
+            expect(points.back().timeMs <= after + ATTACK_SECONDS * 1000.0 + 1.0e-6);
+        }
+
+        engine.stopAutomation(3);
+        expectEquals(cancellations, 1);
+        expectEquals(clockedValues, 0);
+    }
+
+    void testClockedEngineDoesNotSchedule()
+    {
+        beginTest("Clocked automation does not pre-schedule");
+
+        AutomationEngine engine;
+        int scheduledBlocks = 0;
+
+        engine.onClockedOutput = [](int, int) {};
+        engine.onScheduleOutput = [&](int, const std::vector<AutomationEngine::ScheduledPoint>&) { ++scheduledBlocks; };
+        engine.setOutputClockRate(AutomationEngine::DEFAULT_OUTPUT_CLOCK_HZ);
+
+        engine.startAutomation(0, makeRamp());
+        expectEquals(scheduledBlocks, 0);
+        engine.stopAutomation(0);
+    }
+
+    void testPointsReachThePort()
+    {
+        beginTest("Scheduled points reach the port with their timestamps");
+
+        MidiManager manager;
+        auto output = std::make_unique<RecordingUmpOutput>();
+        auto* recorder = output.get();
+        manager.addUmpOutput(std::move(output));
+        manager.setUmpOutputEnabled(true);  // One packet per point
+
+        AutomationEngine engine;
+        std::vector<MidiManager::ScheduledCCValue> values;
+
+        engine.onClockedOutput = [](int, int) {};
+        engine.onScheduleOutput = [&](int, const std::vector<AutomationEngine::ScheduledPoint>& block) {
+            for (const auto& point : block)
+                values.push_back({ point.timeMs, juce::roundToInt(point.value) });
+        };
+        engine.setOutputClockRate(0);
+        engine.startAutomation(0, makeRamp());
+        engine.stopAutomation(0);
+
+        expect(!values.empty());
+        manager.scheduleCC14BitBlock(1, 1, 1, values);
+
+        // An unpaced port keeps every point; ones already due go out at the start of the block
+        expectEquals((int)recorder->packetTimes.size(), (int)values.size());
+        for (size_t i = 1; i < recorder->packetTimes.size(); ++i)
+            expect(recorder->packetTimes[i] >= recorder->packetTimes[i - 1]);
+
+        if (!values.empty() && !recorder->packetTimes.empty())
+            expectEquals(recorder->packetTimes.back(), values.back().timeMs);
+    }
+};
+
+static AutomationEngineScheduledOutputTest automationEngineScheduledOutputTest;
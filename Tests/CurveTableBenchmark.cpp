@@ -0,0 +1,122 @@
+#include <JuceHeader.h>
+#include "../Source/Core/CurveTable.h"
+#include "../Source/Graphics/CurveCalculator.h"
+
+//==============================================================================
+/**
+ * Re-runnable benchmark for curve evaluation: per-point lookups through the shared
+ * CurveTableCache against a table held by the caller, and the visualizer's curve layout
+ * and ball animation. Timings are logged rather than asserted - compare them between
+ * runs on the same machine. Cache keys are checked for sharing and accuracy.
+ */
+class CurveTableBenchmark : public juce::UnitTest
+{
+public:
+    CurveTableBenchmark() : juce::UnitTest("CurveTable benchmark", "CurveTable") {}
+
+    void runTest() override
+    {
+        testCacheKeys();
+        benchmarkPointEvaluation();
+        benchmarkCurveLayout();
+    }
+
+private:
+    static constexpr int NUM_POINTS = 200000;
+    static constexpr int NUM_LAYOUTS = 5000;
+    static constexpr double KEY_ROUNDING_ERROR = 1.2e-5;   // See CurveTableCache
+
+    template <typename Function>
+    static double timeMs(Function&& function)
+    {
+        double start = juce::Time::getMillisecondCounterHiRes();
+        function();
+        return juce::Time::getMillisecondCounterHiRes() - start;
+    }
+
+    void testCacheKeys()
+    {
+        beginTest("Nearby exponents share one accurate table");
+
+        auto& cache = CurveTableCache::getInstance();
+
+        for (double curve : { 0.0, 0.3, 1.0, 1.7, 2.0 })
+        {
+            double exponent = CurveTable::getExponentForCurve(curve);
+            auto table = cache.getTable(exponent);
+
+            // Rounding noise, e.g. from inverting the return curve twice, must not build a second table
+            expect(cache.getTable(exponent + 1.0e-12) == table);
+            expect(cache.getTableForCurve(CurveTable::getInverseCurve(CurveTable::getInverseCurve(curve))) == table);
+
+            double largestError = 0.0;
+            for (int i = 0; i <= 1000; ++i)
+            {
+                double progress = i / 1000.0;
+                largestError = juce::jmax(largestError, std::abs(table->getValue(progress) - std::pow(progress, exponent)));
+            }
+
+            expect(largestError <= table->getMaxError() + KEY_ROUNDING_ERROR);
+        }
+    }
+
+    void benchmarkPointEvaluation()
+    {
+        beginTest("Per-point cache lookups against a held table");
+
+        auto& cache = CurveTableCache::getInstance();
+        const double curve = 0.4;
+        double cachedSum = 0.0, heldSum = 0.0;
+
+        double cachedMs = timeMs([&] {
+            for (int i = 0; i < NUM_POINTS; ++i)
+                cachedSum += cache.applyCurve(i / (double)NUM_POINTS, curve);
+        });
+
+        auto table = cache.getTableForCurve(curve);
+        double heldMs = timeMs([&] {
+            for (int i = 0; i < NUM_POINTS; ++i)
+                heldSum += table->getValue(i / (double)NUM_POINTS);
+        });
+
+        // Same table either way, so the same results
+        expectEquals(heldSum, cachedSum);
+
+        logMessage(juce::String(NUM_POINTS) + " points: " + juce::String(cachedMs, 2) + " ms through the cache, "
+                   + juce::String(heldMs, 2) + " ms from a held table");
+    }
+
+    void benchmarkCurveLayout()
+    {
+        beginTest("Curve layout and ball animation");
+
+        CurveCalculator calculator;
+        const juce::Rectangle<float> bounds(0.0f, 0.0f, 400.0f, 200.0f);
+        const double delay = 1.0, attack = 2.0, release = 1.5, curve = 0.4;
+        CurveCalculator::CurvePoints curvePoints;
+
+        double layoutMs = timeMs([&] {
+            for (int i = 0; i < NUM_LAYOUTS; ++i)
+                curvePoints = calculator.calculateCurvePoints(bounds, delay, attack, release, 0.2 * (i % 8));
+        });
+
+        curvePoints = calculator.calculateCurvePoints(bounds, delay, attack, release, curve);
+        expect(curvePoints.attackCurve != nullptr && curvePoints.returnCurve != nullptr);
+
+        juce::Point<float> ball;
+        double totalTime = delay + attack + release;
+        double animationMs = timeMs([&] {
+            for (int i = 0; i < NUM_POINTS; ++i)
+                ball = calculator.calculateBallPosition(curvePoints, totalTime * i / NUM_POINTS, delay, attack, release, curve);
+        });
+
+        // The return phase starts where the attack ended
+        ball = calculator.calculateBallPosition(curvePoints, delay + attack, delay, attack, release, curve);
+        expectWithinAbsoluteError(ball.y, curvePoints.attackEndPoint.y, 1.0e-3f);
+
+        logMessage(juce::String(NUM_LAYOUTS) + " layouts: " + juce::String(layoutMs, 2) + " ms; "
+                   + juce::String(NUM_POINTS) + " ball positions: " + juce::String(animationMs, 2) + " ms");
+    }
+};
+
+static CurveTableBenchmark curveTableBenchmark;
@@ -0,0 +1,183 @@
+#include <JuceHeader.h>
+#include "../Source/Core/Midi14BitDecoder.h"
+
+//==============================================================================
+/**
+ * Midi14BitDecoder pairs MSB-first and LSB-first senders, holds the leading half for at
+ * most PAIR_TIMEOUT_MS and never merges a lone LSB into an MSB that already went out.
+ */
+class Midi14BitDecoderTest : public juce::UnitTest
+{
+public:
+    Midi14BitDecoderTest() : juce::UnitTest("Midi14BitDecoder", "MidiManager") {}
+
+    void runTest() override
+    {
+        testMsbFirst();
+        testLsbFirst();
+        testHeldMsbTimesOut();
+        testHeldLsbTimesOut();
+        testStandaloneControllers();
+    }
+
+private:
+    using DecodedValue = Midi14BitDecoder::DecodedValue;
+
+    static constexpr int CC = 7;
+    static constexpr double PAIR_GAP_MS = 1.0;     // Within a pair
+    static constexpr double UPDATE_GAP_MS = 5.0;   // Between pairs, inside the timeout
+
+    struct Recorder
+    {
+        Midi14BitDecoder decoder;
+        std::vector<DecodedValue> values;
+
+        void send(int ccNumber, int value, double timeMs)
+        {
+            decoder.process(1, ccNumber, value, timeMs, [this](const DecodedValue& decoded) { values.push_back(decoded); });
+        }
+
+        void flush(double nowMs)
+        {
+            decoder.flushExpired(nowMs, [this](const DecodedValue& decoded) { values.push_back(decoded); });
+        }
+    };
+
+    static int makeValue(int update) { return (update * 1237 + 300) & 0x3FFF; }
+
+    // Sends updates 0..numUpdates-1 in the given order and returns the time after the last
+    static double sendUpdates(Recorder& recorder, int numUpdates, bool lsbFirst)
+    {
+        double time = 0.0;
+        for (int update = 0; update < numUpdates; ++update, time += UPDATE_GAP_MS)
+        {
+            int value = makeValue(update);
+            if (lsbFirst)
+            {
+                recorder.send(CC + 32, value & 0x7F, time);
+                recorder.send(CC, value >> 7, time + PAIR_GAP_MS);
+            }
+            else
+            {
+                recorder.send(CC, value >> 7, time);
+                recorder.send(CC + 32, value & 0x7F, time + PAIR_GAP_MS);
+            }
+        }
+        return time;
+    }
+
+    void expectPairedUpdates(const Recorder& recorder, int firstPairedIndex, int numUpdates)
+    {
+        // The first update only teaches the decoder the order, every later one is one paired value
+        expectEquals((int)recorder.values.size(), firstPairedIndex + numUpdates - 1);
+        for (int update = 1; update < numUpdates; ++update)
+        {
+            const auto& decoded = recorder.values[(size_t)(firstPairedIndex + update - 1)];
+            expect(decoded.isHighResolution);
+            expectEquals(decoded.ccNumber, CC);
+            expectEquals(decoded.value14bit, makeValue(update));
+        }
+        expectEquals((int)recorder.decoder.getPairedValueCount(), numUpdates - 1);
+    }
+
+    void testMsbFirst()
+    {
+        beginTest("MSB-first sender pairs every update after the first");
+
+        Recorder recorder;
+        sendUpdates(recorder, 8, false);
+
+        // First update: a 7-bit MSB, then its LSB as a controller of its own
+        expectEquals(recorder.values[0].ccNumber, CC);
+        expect(!recorder.values[0].isHighResolution);
+        expectEquals(recorder.values[1].ccNumber, CC + 32);
+        expectPairedUpdates(recorder, 2, 8);
+    }
+
+    void testLsbFirst()
+    {
+        beginTest("LSB-first sender pairs every update after the first");
+
+        Recorder recorder;
+        sendUpdates(recorder, 8, true);
+
+        // First update: the LSB as a controller of its own, then the MSB with its LSB taken as zero
+        expectEquals(recorder.values[0].ccNumber, CC + 32);
+        expectEquals(recorder.values[1].ccNumber, CC);
+        expectEquals(recorder.values[1].value14bit, (makeValue(0) >> 7) << 7);
+        expectPairedUpdates(recorder, 2, 8);
+    }
+
+    void testHeldMsbTimesOut()
+    {
+        beginTest("A held MSB is released after the pair timeout");
+
+        Recorder recorder;
+        double time = sendUpdates(recorder, 2, false);
+        recorder.values.clear();
+
+        recorder.send(CC, 100, time);
+        recorder.flush(time + Midi14BitDecoder::PAIR_TIMEOUT_MS);
+        expect(recorder.values.empty(), "Still inside the timeout");
+
+        recorder.flush(time + Midi14BitDecoder::PAIR_TIMEOUT_MS + 1.0);
+        expectEquals((int)recorder.values.size(), 1);
+        expectEquals(recorder.values[0].ccNumber, CC);
+        expectEquals(recorder.values[0].value14bit, 100 << 7);
+        expectEquals(recorder.values[0].timeMs, time);
+
+        // A late LSB is not merged into the released MSB
+        recorder.send(CC + 32, 5, time + Midi14BitDecoder::PAIR_TIMEOUT_MS + 2.0);
+        expectEquals((int)recorder.values.size(), 2);
+        expectEquals(recorder.values[1].ccNumber, CC + 32);
+        expect(!recorder.values[1].isHighResolution);
+    }
+
+    void testHeldLsbTimesOut()
+    {
+        beginTest("A held LSB is released after the pair timeout");
+
+        Recorder recorder;
+        double time = sendUpdates(recorder, 2, true);
+        recorder.values.clear();
+
+        recorder.send(CC + 32, 42, time);
+        recorder.flush(time + Midi14BitDecoder::PAIR_TIMEOUT_MS);
+        expect(recorder.values.empty(), "Still inside the timeout");
+
+        recorder.flush(time + Midi14BitDecoder::PAIR_TIMEOUT_MS + 1.0);
+        expectEquals((int)recorder.values.size(), 1);
+        expectEquals(recorder.values[0].ccNumber, CC + 32);
+        expectEquals(recorder.values[0].value14bit, 42 << 7);
+        expect(!recorder.values[0].isHighResolution);
+
+        // A late MSB is not paired with the released LSB
+        recorder.send(CC, 9, time + Midi14BitDecoder::PAIR_TIMEOUT_MS + 2.0);
+        expectEquals((int)recorder.values.size(), 2);
+        expectEquals(recorder.values[1].value14bit, 9 << 7);
+        expectEquals((int)recorder.decoder.getPairedValueCount(), 1);
+    }
+
+    void testStandaloneControllers()
+    {
+        beginTest("Controllers without a partner pass straight through");
+
+        Recorder recorder;
+
+        // MSB-only and LSB-only controllers, and a CC that is never paired
+        for (int i = 0; i < 4; ++i)
+        {
+            recorder.send(1, i, i * UPDATE_GAP_MS);
+            recorder.send(32 + 2, i, i * UPDATE_GAP_MS);
+            recorder.send(74, i, i * UPDATE_GAP_MS);
+        }
+
+        expectEquals((int)recorder.values.size(), 12);
+        for (const auto& decoded : recorder.values)
+            expect(!decoded.isHighResolution);
+        expectEquals((int)recorder.decoder.getStandaloneLsbCount(), 4);
+        expectEquals((int)recorder.decoder.getPairedValueCount(), 0);
+    }
+};
+
+static Midi14BitDecoderTest midi14BitDecoderTest;
@@ -0,0 +1,175 @@
+#include <JuceHeader.h>
+#include "../Source/Core/CoreLog.h"
+#include "../Source/Core/MidiManager.h"
+#include "../Source/Core/Midi7BitController.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+//==============================================================================
+// Counting global operator new. Only the thread that switched counting on is
+// counted, so JUCE's own threads can't make the test flaky.
+namespace
+{
+    thread_local bool countAllocationsOnThisThread = false;
+    std::atomic<int> allocationCount { 0 };
+
+    void* allocate(std::size_t size)
+    {
+        if (countAllocationsOnThisThread)
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (auto* memory = std::malloc(size == 0 ? 1 : size))
+            return memory;
+
+        throw std::bad_alloc();
+    }
+
+    template <typename Function>
+    int countAllocations(Function&& function)
+    {
+        allocationCount = 0;
+        countAllocationsOnThisThread = true;
+        function();
+        countAllocationsOnThisThread = false;
+        return allocationCount.load();
+    }
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+//==============================================================================
+/**
+ * Incoming MIDI from the MIDI callback through the message thread's dispatch into
+ * Midi7BitController, and the output thread's queue drain into real device sinks, must not
+ * allocate. Both run at release log level - debug logging formats strings by design.
+ */
+class MidiManagerAllocationTest : public juce::UnitTest
+{
+public:
+    MidiManagerAllocationTest() : juce::UnitTest("MidiManager hot path allocations", "MidiManager") {}
+
+    void runTest() override
+    {
+       #if CORE_LOG_LEVEL < 3
+        beginTest("Skipped");
+        logMessage("Build with CORE_LOG_LEVEL=3 (the release default) to run the allocation checks");
+        expect(true);
+       #else
+        testInputDispatch(true);
+        testInputDispatch(false);
+
+        for (auto sink : { OutputSink::midiDevice, OutputSink::umpBytestream })
+        {
+            testOutputDrain(sink, false);
+            testOutputDrain(sink, true);
+        }
+       #endif
+    }
+
+private:
+    enum class OutputSink { midiDevice, umpBytestream };
+
+    static constexpr int MESSAGES_PER_ROUND = 64;
+    static constexpr int NUM_MAPPED_SLIDERS = 16;
+
+    void testInputDispatch(bool highResolution)
+    {
+        beginTest(highResolution ? "Input dispatch with 14-bit decoding" : "Input dispatch without 14-bit decoding");
+
+        MidiManager manager;
+        manager.setHighResolutionInputEnabled(highResolution);
+        MidiManager::InputPort port(manager, 0);
+
+        // Map CC 0-15 on channel 1 to sliders 0-15 through learn mode, as the app does
+        Midi7BitController controller;
+        controller.startLearnMode();
+        for (int slider = 0; slider < NUM_MAPPED_SLIDERS; ++slider)
+        {
+            controller.setLearnTarget(MidiTargetType::SliderValue, slider);
+            controller.processIncomingCC(slider, 0, 1);
+        }
+        controller.stopLearnMode();
+
+        // Wired like DebugMidiController
+        int sliderUpdates = 0, monitoredEvents = 0;
+        controller.onSliderValueChanged = [&](int, double, bool) { ++sliderUpdates; };
+        manager.onMidiReceived = [&](int channel, int ccNumber, int value) { controller.processIncomingCC(ccNumber, value, channel); };
+        manager.onHighResolutionMidiReceived = [&](int channel, int ccNumber, int value14bit) {
+            controller.processIncoming14BitCC(ccNumber, value14bit, channel);
+        };
+        manager.onMidiReceiveForMonitor = [&](int, int, int, const juce::String&, int) { ++monitoredEvents; };
+
+        // MSB/LSB pairs on the mapped CCs, built up front so the messages themselves aren't counted
+        std::vector<juce::MidiMessage> messages;
+        for (int i = 0; i < MESSAGES_PER_ROUND / 2; ++i)
+        {
+            int ccNumber = i % NUM_MAPPED_SLIDERS;
+            messages.push_back(juce::MidiMessage::controllerEvent(1, ccNumber, i));
+            messages.push_back(juce::MidiMessage::controllerEvent(1, ccNumber + 32, 127 - i));
+        }
+
+        // The MIDI thread's callback, then the message thread's per-frame dispatch
+        auto feedAndDispatch = [&] {
+            for (auto& message : messages)
+                manager.handleIncomingMidiMessage(port, message);
+            manager.dispatchIncomingMidi();
+        };
+
+        // First pass warms up singletons, timers and lazily sized state
+        feedAndDispatch();
+        controller.stopTimer();
+
+        int updatesBefore = sliderUpdates;
+        expectEquals(countAllocations(feedAndDispatch), 0);
+        controller.stopTimer();
+
+        expect(sliderUpdates > updatesBefore);
+        expect(monitoredEvents > 0);
+    }
+
+    void testOutputDrain(OutputSink sink, bool coalesce)
+    {
+        juce::String sinkName = sink == OutputSink::midiDevice ? "MIDI 1.0 port" : "bytestream UMP port";
+        beginTest("Output drain to a " + sinkName + (coalesce ? " with coalescing" : " without coalescing"));
+
+        // The real device sinks, on a virtual port so no hardware is needed
+        MidiManager manager;
+        int portIndex = -1;
+        if (sink == OutputSink::midiDevice)
+            portIndex = manager.addVirtualOutput("Allocation Test Output");
+        else if (auto device = juce::MidiOutput::createNewDevice("Allocation Test UMP Output"))
+            portIndex = manager.addUmpOutput(std::make_unique<MidiUmpBytestreamOutput>(std::move(device)));
+
+        if (portIndex < 0)
+        {
+            logMessage("Virtual MIDI outputs are not supported on this platform - skipped");
+            return;
+        }
+
+        manager.setOutputCoalescingEnabled(coalesce);
+
+        // The output thread is never started, so the test stands in for it.
+        // Each round moves every value so the coalescer has something new to send.
+        int round = 0;
+        auto sendAndDrain = [&] {
+            ++round;
+            for (int i = 0; i < MESSAGES_PER_ROUND; ++i)
+                manager.sendCC14BitWithSlider(i % 16, 1 + (i % 16), i % 32, (i * 200 + round) & 0x3FFF);
+
+            manager.drainOutputQueue();
+            manager.flushCoalescedOutput();
+        };
+
+        sendAndDrain();
+
+        expectEquals(countAllocations(sendAndDrain), 0);
+    }
+};
+
+static MidiManagerAllocationTest midiManagerAllocationTest;
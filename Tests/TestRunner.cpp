@@ -0,0 +1,25 @@
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+ * Console runner for the juce::UnitTests in this directory.
+ * Pass a category (e.g. "MidiManager") to run only those tests.
+ */
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    if (argc > 1)
+        runner.runTestsInCategory(argv[1]);
+    else
+        runner.runAllTests();
+
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        failures += runner.getResult(i)->failures;
+
+    return failures > 0 ? 1 : 0;
+}